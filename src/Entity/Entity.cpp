@@ -1,30 +1,33 @@
-#include <random>
 #include <iostream>
 #include <utility>
 #include <cmath>
 #include "Entity.h"
 #include "TraitManager.h"
-#include <SDL2/SDL2_gfxPrimitives.h>
 #include <algorithm>
-#include <sstream>
-#include <iomanip>
 
 // Generates a random color for the entity
-SDL_Color Entity::generateRandomColor() {
-    return { (Uint8)(std::rand() % 256), (Uint8)(std::rand() % 256), (Uint8)(std::rand() % 256), 255 };
+Color Entity::generateRandomColor(RandomStream& rng) {
+    std::uint8_t r = (std::uint8_t)rng.nextInt(256);
+    std::uint8_t g = (std::uint8_t)rng.nextInt(256);
+    std::uint8_t b = (std::uint8_t)rng.nextInt(256);
+    return { r, g, b, 255 };
 }
 
 // Calculates derived stats based on genetic code and traits
 void Entity::calculateDerivedStats() {
     // Extract genetic code and trait data
-    const int radBase = (int)geneticCode[0];
-    const int entityType = getEntityType();
-    const int weaponGene = (int)geneticCode[1];
-    const float staminaEfficiency = geneticCode[4];
-    const float myopiaFactor = geneticCode[6];
-    const int fertilityFactor = (int)geneticCode[9];
-    const int traitID = (int)std::round(geneticCode[11]);
-    const TraitStats& traitStats = TraitManager::get(traitID);
+    const int radBase = (int)genome[0];
+
+    // Role from the role gene (cached: it is read in every perception and combat branch)
+    const float roleGene = genome[10];
+    this->entityType = (roleGene < 0.33f) ? MELEE : (roleGene < 0.66f) ? RANGED : HEALER;
+    const int weaponGene = (int)genome[1];
+    const float staminaEfficiency = genome[4];
+    const float myopiaFactor = genome[6];
+    const int fertilityFactor = (int)genome[9];
+    const int traitID = (int)std::round(genome[11]);
+    this->traitStats = &TraitManager::get(traitID);
+    const TraitStats& traitStats = *this->traitStats;
 
     // Global balancing constants
     const float HEALTH_MULTIPLIER = 4.0f;
@@ -44,7 +47,7 @@ void Entity::calculateDerivedStats() {
     this->speed = (int)(rawSpeed * traitStats.speedMult);
     if (this->speed < MIN_SPEED) this->speed = (int)MIN_SPEED;
     this->maxStamina = (int)(rawMaxStamina * traitStats.maxStaminaMult);
-    this->stamina = this->maxStamina;
+    state.stamina = this->maxStamina;
     this->rad = (int)(radBase * traitStats.radMult);
     this->armor += traitStats.armorFlatBonus;
 
@@ -54,7 +57,7 @@ void Entity::calculateDerivedStats() {
     this->maxHealth -= (int)(this->maxHealth * 0.10f * fertilityFactor);
     this->maxHealth = (int)(this->maxHealth * traitStats.maxHealthMult);
     if (this->maxHealth < 1) this->maxHealth = 1;
-    this->health = this->maxHealth;
+    state.health = this->maxHealth;
 
     // Combat stats based on entity type
     float traitDmgMult = traitStats.damageMult;
@@ -68,14 +71,14 @@ void Entity::calculateDerivedStats() {
         damage = MIN_RANGED_DMG + (int)(powerBias * (MAX_RANGED_DMG - MIN_RANGED_DMG));
         damage = (int)(damage * traitDmgMult);
         attackRange = MIN_RANGED_RANGE + (int)(rangeBias * (MAX_RANGED_RANGE - MIN_RANGED_RANGE));
-        attackCooldown = 500 + (Uint32)(powerBias * 2000);
+        attackCooldown = 500 + (std::uint32_t)(powerBias * 2000);
         projectileSpeed = 14 - (int)(powerBias * 6);
         projectileRadius = 4 + (int)(powerBias * 8);
         staminaAttackCost = 5 + (int)(powerBias * 20);
 
         if (entityType == 2) { // Healer specialization
             this->maxHealth = (int)(this->maxHealth * 1.3f);
-            this->health = this->maxHealth;
+            state.health = this->maxHealth;
             this->armor += 0.10f;
             damage = (int)(damage * 0.5f);
             if (damage < 1) damage = 1;
@@ -87,7 +90,7 @@ void Entity::calculateDerivedStats() {
 
         damage = MIN_MELEE_DMG + (int)(sizeBias * (MAX_MELEE_DMG - MIN_MELEE_DMG));
         damage = (int)(damage * traitDmgMult);
-        attackCooldown = MIN_MELEE_COOLDOWN + (Uint32)(sizeBias * (MAX_MELEE_COOLDOWN - MIN_MELEE_COOLDOWN));
+        attackCooldown = MIN_MELEE_COOLDOWN + (std::uint32_t)(sizeBias * (MAX_MELEE_COOLDOWN - MIN_MELEE_COOLDOWN));
         attackRange = 50 + (int)(sizeBias * 40);
         projectileSpeed = 0;
         projectileRadius = 0;
@@ -95,7 +98,7 @@ void Entity::calculateDerivedStats() {
 
         this->armor += 0.15f;
         this->maxHealth += 20;
-        this->health = this->maxHealth;
+        state.health = this->maxHealth;
     }
 
     // Final adjustments
@@ -103,311 +106,183 @@ void Entity::calculateDerivedStats() {
     this->staminaAttackCost = (int)(this->staminaAttackCost * (1.0f - staminaEfficiency));
     if (this->staminaAttackCost < 1) this->staminaAttackCost = 1;
 
-    if (this->getEntityType() == 2) {
+    if (entityType == HEALER) {
         this->maxHealth = (int)(this->maxHealth * 0.60f);
         this->damage = (int)(this->damage * 0.50f);
     }
 }
 
 // Constructor: Initializes the entity with its genetic code and other properties
-Entity::Entity(std::string name, int x, int y, SDL_Color color,
-               const float geneticCode[12], int generation,
-               std::string p1_name, std::string p2_name) :
-        x(x), y(y), color(color), name(std::move(name)),
-        generation(generation), parent1_name(std::move(p1_name)), parent2_name(std::move(p2_name)) {
-    for (int i = 0; i < 14; ++i) this->geneticCode[i] = geneticCode[i];
-    this->rad = (int)geneticCode[0];
-    direction[0] = 0;
-    direction[1] = 0;
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<> dis_angle(0, 2 * M_PI);
-    float angle = dis_angle(gen);
-    lastVelX = cos(angle);
-    lastVelY = sin(angle);
-    Uint32 startTime = SDL_GetTicks();
-    lastRegenTick = startTime - (std::rand() % REGEN_COOLDOWN_MS);
-    lastStaminaUseTick = startTime;
-    isFleeing = false;
-    isCharging = false;
+Entity::Entity(EntityId id, int x, int y, Color color, const Genome& genome, RandomStream& rng) :
+        id(id), color(color), genome(genome) {
+    this->rad = (int)genome[0];
+    state.x = x;
+    state.y = y;
+    float angle = rng.nextRange(0.0f, 2.0f * (float)M_PI);
+    state.lastVelX = cos(angle);
+    state.lastVelY = sin(angle);
+    state.lastRegenTick = -(SimTick)rng.nextInt((int)REGEN_COOLDOWN_TICKS);
     calculateDerivedStats();
 }
 
-// Destructor: Default behavior
-Entity::~Entity() = default;
+// Updates the entity's state for one tick, including movement, stamina, and health regeneration
+void Entity::update(SimTick now, RandomStream& rng) {
+    if (!state.isAlive) return;
 
-// Draws the entity on the screen, including debug visuals and health/stamina bars
-void Entity::draw(SDL_Renderer* renderer, const Camera& cam, bool showDebug) {
-    // Transform camera coordinates
-    int screenX = (int)((x - cam.x) * cam.zoom);
-    int screenY = (int)((y - cam.y) * cam.zoom);
-    int screenRad = (int)(rad * cam.zoom);
-
-    // Skip drawing if off-screen
-    if (screenX + screenRad < 0 || screenX - screenRad > WINDOW_WIDTH ||
-        screenY + screenRad < 0 || screenY - screenRad > WINDOW_HEIGHT) {
-        return;
-    }
-
-    // Flash effect when eating
-    if (flashTimer > 0) {
-        filledCircleRGBA(renderer, screenX, screenY, screenRad, 255, 255, 255, 255);
-        flashTimer--;
-    } else {
-        // Draw entity based on type
-        int type = getEntityType();
-
-        if (type == 1) {
-            // Ranged
-            filledCircleRGBA(renderer, screenX, screenY, screenRad, color.r, color.g, color.b, 255);
-            filledCircleRGBA(renderer, screenX, screenY, (int)(screenRad * 0.65f), 20, 20, 20, 255);
-            filledCircleRGBA(renderer, screenX, screenY, (int)(screenRad * 0.30f), color.r, color.g, color.b, 255);
-            circleRGBA(renderer, screenX, screenY, (int)(screenRad * 0.35f), 255, 255, 255, 100);
-        } else if (type == 2) {
-            // Healer
-            filledCircleRGBA(renderer, screenX, screenY, screenRad, color.r, color.g, color.b, 255);
-
-            Uint8 r_dark = (Uint8)(color.r * 0.7f);
-            Uint8 g_dark = (Uint8)(color.g * 0.7f);
-            Uint8 b_dark = (Uint8)(color.b * 0.7f);
-            circleRGBA(renderer, screenX, screenY, screenRad, r_dark, g_dark, b_dark, 255);
-
-            int w = (int)(screenRad * 0.5f);
-            int t = (int)(screenRad * 0.2f);
-            boxRGBA(renderer, screenX - w, screenY - t, screenX + w, screenY + t, 40, 40, 40, 255);
-            boxRGBA(renderer, screenX - t, screenY - w, screenX + t, screenY + w, 40, 40, 40, 255);
-
-            rectangleRGBA(renderer, screenX - w, screenY - t, screenX + w, screenY + t, 255, 255, 255, 100);
-            rectangleRGBA(renderer, screenX - t, screenY - w, screenX + t, screenY + w, 255, 255, 255, 100);
-        } else {
-            // Melee
-            Uint8 r_dark = (Uint8)(color.r * 0.6f);
-            Uint8 g_dark = (Uint8)(color.g * 0.6f);
-            Uint8 b_dark = (Uint8)(color.b * 0.6f);
-            filledCircleRGBA(renderer, screenX, screenY, screenRad, r_dark, g_dark, b_dark, 255);
-            filledCircleRGBA(renderer, screenX, screenY, (int)(screenRad * 0.75f), color.r, color.g, color.b, 255);
-        }
-    }
-
-    // Debug visuals
-    if (showDebug) {
-        int screenSight = (int)(sightRadius * cam.zoom);
-        circleRGBA(renderer, screenX, screenY, screenSight, 255, 255, 255, 50);
-        if (isCharging) {
-            circleRGBA(renderer, screenX, screenY, screenRad + 3, 255, 50, 50, 255);
-        }
-        stringRGBA(renderer, screenX - (int)(0.1 * screenRad), screenY - (int)(0.1 * screenRad), std::to_string(health).c_str(), 255, 255, 255, 255);
-    }
-
-    // Health and stamina bars
-    int barWidth = (int)(6 * cam.zoom);
-    if (barWidth < 2) barWidth = 2;
-    int barHeight = 2 * screenRad;
-    int offset = screenRad + barWidth + 2;
-
-    float healthPercent = std::clamp((float)health / (float)maxHealth, 0.0f, 1.0f);
-    float staminaPercent = std::clamp((float)stamina / (float)maxStamina, 0.0f, 1.0f);
-
-    // Health bar
-    SDL_Rect healthBarBg = {screenX - offset - barWidth, screenY - barHeight / 2, barWidth, barHeight};
-    SDL_SetRenderDrawColor(renderer, 40, 40, 40, 255);
-    SDL_RenderFillRect(renderer, &healthBarBg);
-
-    int healthFillHeight = static_cast<int>(barHeight * healthPercent + 0.5f);
-    if (healthFillHeight > 0) {
-        SDL_Rect healthBar = {screenX - offset - barWidth, screenY + barHeight / 2 - healthFillHeight, barWidth, healthFillHeight};
-        SDL_SetRenderDrawColor(renderer, 220, 20, 20, 255);
-        SDL_RenderFillRect(renderer, &healthBar);
-    }
-
-    // Stamina bar
-    SDL_Rect staminaBarBg = {screenX + offset, screenY - barHeight / 2, barWidth, barHeight};
-    SDL_SetRenderDrawColor(renderer, 40, 40, 40, 255);
-    SDL_RenderFillRect(renderer, &staminaBarBg);
-
-    int staminaFillHeight = static_cast<int>(barHeight * staminaPercent + 0.5f);
-    if (staminaFillHeight > 0) {
-        SDL_Rect staminaBar = {screenX + offset, screenY + barHeight / 2 - staminaFillHeight, barWidth, staminaFillHeight};
-        SDL_SetRenderDrawColor(renderer, 20, 100, 255, 255);
-        SDL_RenderFillRect(renderer, &staminaBar);
-    }
-}
-
-// Updates the entity's state, including movement, stamina, and health regeneration
-void Entity::update(int speedMultiplier) {
-    if (!isAlive) return;
-
-    Uint32 currentTime = SDL_GetTicks();
-    Uint32 effectiveRegenCooldown = (speedMultiplier > 0) ? (REGEN_COOLDOWN_MS / speedMultiplier) : REGEN_COOLDOWN_MS;
-    Uint32 effectiveStaminaDelay = (speedMultiplier > 0) ? (STAMINA_REGEN_DELAY_MS / speedMultiplier) : STAMINA_REGEN_DELAY_MS;
-
-    float agingRate = geneticCode[8];
-    float baseHealthRegen = geneticCode[5];
+    float agingRate = genome[8];
+    float baseHealthRegen = genome[5];
 
     // Aging effect
     if (agingRate > 0.0f) {
-        this->maxHealth -= (int)(this->maxHealth * agingRate * 0.001f * speedMultiplier);
+        this->maxHealth -= (int)(this->maxHealth * agingRate * 0.001f);
         if (this->maxHealth < 1) this->maxHealth = 1;
-        if (this->health > this->maxHealth) this->health = this->maxHealth;
+        if (state.health > this->maxHealth) state.health = this->maxHealth;
     }
 
     // Health regeneration
-    if (baseHealthRegen > 0.0f && health < maxHealth) {
-        if (currentTime > lastRegenTick + effectiveRegenCooldown) {
-            health += (int)baseHealthRegen;
-            if (health > maxHealth) health = maxHealth;
-            lastRegenTick = currentTime;
+    if (baseHealthRegen > 0.0f && state.health < maxHealth) {
+        if (now - state.lastRegenTick >= REGEN_COOLDOWN_TICKS) {
+            state.health += (int)baseHealthRegen;
+            if (state.health > maxHealth) state.health = maxHealth;
+            state.lastRegenTick = now;
         }
     }
 
     // Stamina consumption
     bool staminaConsumed = false;
-    if (isFleeing) {
-        int traitID = (int)std::round(geneticCode[11]);
-        float moveCostMult = TraitManager::get(traitID).staminaMoveCostMult;
+    if (state.isFleeing) {
+        float moveCostMult = traitStats->staminaMoveCostMult;
         int cost = (int)(STAMINA_FLEE_COST_PER_FRAME * moveCostMult);
         if (cost < 1) cost = 1;
 
-        if (stamina > 0) {
-            stamina -= cost;
-            lastStaminaUseTick = currentTime;
+        if (state.stamina > 0) {
+            state.stamina -= cost;
+            state.lastStaminaUseTick = now;
             staminaConsumed = true;
-            if (stamina < 0) stamina = 0;
+            if (state.stamina < 0) state.stamina = 0;
         } else {
-            isFleeing = false;
+            state.isFleeing = false;
         }
-    } else if (isCharging) {
-        if (stamina > 0) {
-            stamina -= STAMINA_CHARGE_COST_PER_FRAME;
-            lastStaminaUseTick = currentTime;
+    } else if (state.isCharging) {
+        if (state.stamina > 0) {
+            state.stamina -= STAMINA_CHARGE_COST_PER_FRAME;
+            state.lastStaminaUseTick = now;
             staminaConsumed = true;
-            if (stamina < 0) stamina = 0;
+            if (state.stamina < 0) state.stamina = 0;
         } else {
-            isCharging = false;
+            state.isCharging = false;
         }
     }
 
     // Stamina regeneration
-    int traitID = (int)std::round(geneticCode[11]);
-    float regenBonus = TraitManager::get(traitID).staminaRegenBonus;
+    float regenBonus = traitStats->staminaRegenBonus;
     int netRegen = STAMINA_REGEN_RATE + (int)regenBonus;
 
     if (netRegen < 0) {
-        int tickRate = 2 * (speedMultiplier > 0 ? speedMultiplier : 1);
-        if (currentTime % tickRate == 0) {
-            stamina += netRegen;
-            if (stamina < 0) stamina = 0;
+        if (now % STAMINA_DRAIN_INTERVAL_TICKS == 0) {
+            state.stamina += netRegen;
+            if (state.stamina < 0) state.stamina = 0;
         }
-    } else if (!staminaConsumed && stamina < maxStamina && currentTime > lastStaminaUseTick + effectiveStaminaDelay) {
-        stamina += netRegen;
-        if (stamina > maxStamina) stamina = maxStamina;
+    } else if (!staminaConsumed && state.stamina < maxStamina && now - state.lastStaminaUseTick >= STAMINA_REGEN_DELAY_TICKS) {
+        state.stamina += netRegen;
+        if (state.stamina > maxStamina) state.stamina = maxStamina;
     }
 
     // Death check
-    if (health <= 0) {
+    if (state.health <= 0) {
         die();
         return;
     }
 
     // Movement and physics
     float dynamicSpeed = (float)speed;
-    if (isCharging) dynamicSpeed *= 1.8f;
-    else if (isFleeing) dynamicSpeed *= 0.8f;
+    if (state.isCharging) dynamicSpeed *= 1.8f;
+    else if (state.isFleeing) dynamicSpeed *= 0.8f;
 
-    int currentSpeed = (int)(dynamicSpeed * (float)speedMultiplier);
+    int currentSpeed = (int)dynamicSpeed;
     if (currentSpeed < 1) currentSpeed = 1;
 
-    if (direction[0] == 0 && direction[1] == 0) chooseDirection();
+    if (state.direction[0] == 0 && state.direction[1] == 0) chooseDirection(rng);
 
-    float distX = direction[0] - x;
-    float distY = direction[1] - y;
+    float distX = state.direction[0] - state.x;
+    float distY = state.direction[1] - state.y;
     float distance = std::sqrt(distX * distX + distY * distY);
 
     if (distance < currentSpeed && distance > 0.0f) {
-        x += (int)distX;
-        y += (int)distY;
-        direction[0] = 0;
-        direction[1] = 0;
-        clearTarget();
+        state.x += (int)distX;
+        state.y += (int)distY;
+        state.direction[0] = 0;
+        state.direction[1] = 0;
     } else if (distance > 0.0f) {
         float normX = distX / distance;
         float normY = distY / distance;
-        x += static_cast<int>(normX * currentSpeed);
-        y += static_cast<int>(normY * currentSpeed);
-        lastVelX = normX;
-        lastVelY = normY;
+        state.x += static_cast<int>(normX * currentSpeed);
+        state.y += static_cast<int>(normY * currentSpeed);
+        state.lastVelX = normX;
+        state.lastVelY = normY;
     }
 
     // World boundary collision
     bool collided = false;
-    if (x < rad) {
-        x = rad;
+    if (state.x < rad) {
+        state.x = rad;
         collided = true;
-    } else if (x > WORLD_WIDTH - rad) {
-        x = WORLD_WIDTH - rad;
+    } else if (state.x > WORLD_WIDTH - rad) {
+        state.x = WORLD_WIDTH - rad;
         collided = true;
     }
 
-    if (y < rad) {
-        y = rad;
+    if (state.y < rad) {
+        state.y = rad;
         collided = true;
-    } else if (y > WORLD_HEIGHT - rad) {
-        y = WORLD_HEIGHT - rad;
+    } else if (state.y > WORLD_HEIGHT - rad) {
+        state.y = WORLD_HEIGHT - rad;
         collided = true;
     }
 
     if (collided) {
-        direction[0] = 0;
-        direction[1] = 0;
-        clearTarget();
-        lastVelX = -lastVelX;
-        lastVelY = -lastVelY;
-        isCharging = false;
-        isFleeing = false;
+        state.direction[0] = 0;
+        state.direction[1] = 0;
+        state.lastVelX = -state.lastVelX;
+        state.lastVelY = -state.lastVelY;
+        state.isCharging = false;
+        state.isFleeing = false;
     }
 }
 
 // Chooses a new direction for the entity to move toward
-void Entity::chooseDirection(int target[2]) {
+void Entity::chooseDirection(RandomStream& rng, int target[2]) {
     if (target != nullptr) {
-        direction[0] = target[0];
-        direction[1] = target[1];
-        targetX = target[0];
-        targetY = target[1];
+        state.direction[0] = target[0];
+        state.direction[1] = target[1];
     } else {
-        targetX = -1;
-        targetY = -1;
         const float WANDER_DISTANCE = 90.0f;
         const float WANDER_JITTER_STRENGTH = 0.4f;
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_real_distribution<> dis_jitter(-1.0, 1.0);
-        float jitterX = dis_jitter(gen);
-        float jitterY = dis_jitter(gen);
-        float newDirX = (lastVelX * (1.0f - WANDER_JITTER_STRENGTH)) + jitterX * WANDER_JITTER_STRENGTH;
-        float newDirY = (lastVelY * (1.0f - WANDER_JITTER_STRENGTH)) + jitterY * WANDER_JITTER_STRENGTH;
+        float jitterX = rng.nextRange(-1.0f, 1.0f);
+        float jitterY = rng.nextRange(-1.0f, 1.0f);
+        float newDirX = (state.lastVelX * (1.0f - WANDER_JITTER_STRENGTH)) + jitterX * WANDER_JITTER_STRENGTH;
+        float newDirY = (state.lastVelY * (1.0f - WANDER_JITTER_STRENGTH)) + jitterY * WANDER_JITTER_STRENGTH;
         float newMag = std::sqrt(newDirX * newDirX + newDirY * newDirY);
         if (newMag > 0.0f) {
             newDirX /= newMag;
             newDirY /= newMag;
         } else {
-            std::uniform_real_distribution<> dis_angle(0, 2 * M_PI);
-            float angle = dis_angle(gen);
+            float angle = rng.nextRange(0.0f, 2.0f * (float)M_PI);
             newDirX = cos(angle);
             newDirY = sin(angle);
         }
 
-        direction[0] = x + static_cast<int>(newDirX * WANDER_DISTANCE);
-        direction[1] = y + static_cast<int>(newDirY * WANDER_DISTANCE);
-        lastVelX = newDirX;
-        lastVelY = newDirY;
+        state.direction[0] = state.x + static_cast<int>(newDirX * WANDER_DISTANCE);
+        state.direction[1] = state.y + static_cast<int>(newDirY * WANDER_DISTANCE);
+        state.lastVelX = newDirX;
+        state.lastVelY = newDirY;
     }
 }
 
 // Applies a knockback effect to the entity
 void Entity::knockBackFrom(int sourceX, int sourceY, int force) {
-    float dx = (float)(x - sourceX);
-    float dy = (float)(y - sourceY);
+    float dx = (float)(state.x - sourceX);
+    float dy = (float)(state.y - sourceY);
     float dist = std::sqrt(dx * dx + dy * dy);
     if (dist < 0.1f) {
         dx = 1.0f;
@@ -416,41 +291,40 @@ void Entity::knockBackFrom(int sourceX, int sourceY, int force) {
     }
     float normX = dx / dist;
     float normY = dy / dist;
-    x += (int)(normX * (float)force);
-    y += (int)(normY * (float)force);
+    state.x += (int)(normX * (float)force);
+    state.y += (int)(normY * (float)force);
 
-    x = std::clamp(x, rad, WORLD_WIDTH - rad);
-    y = std::clamp(y, rad, WORLD_HEIGHT - rad);
+    state.x = std::clamp(state.x, rad, WORLD_WIDTH - rad);
+    state.y = std::clamp(state.y, rad, WORLD_HEIGHT - rad);
 
-    direction[0] = 0;
-    direction[1] = 0;
-    clearTarget();
-    isCharging = false;
-    isFleeing = false;
+    state.direction[0] = 0;
+    state.direction[1] = 0;
+    state.isCharging = false;
+    state.isFleeing = false;
 }
 
 // Reduces the entity's health when taking damage
 void Entity::takeDamage(int amount) {
-    if (!isAlive) return;
-    float damageFragility = geneticCode[3];
+    if (!state.isAlive) return;
+    float damageFragility = genome[3];
     float totalDamageModifier = (1.0f - armor) + damageFragility;
     int damageTaken = static_cast<int>(amount * totalDamageModifier);
     if (damageTaken < 1 && amount > 0) damageTaken = 1;
-    this->health -= damageTaken;
-    if (this->health <= 0) {
-        health = 0;
+    state.health -= damageTaken;
+    if (state.health <= 0) {
+        state.health = 0;
         die();
     }
 }
 
 // Consumes stamina for an action, returning whether the action is possible
-bool Entity::consumeStamina(int amount) {
-    float staminaEfficiency = geneticCode[4];
+bool Entity::consumeStamina(int amount, SimTick now) {
+    float staminaEfficiency = genome[4];
     int actualCost = (int)(amount * (1.0f - staminaEfficiency));
     if (actualCost < 1) actualCost = 1;
-    if (stamina >= actualCost) {
-        stamina -= actualCost;
-        lastStaminaUseTick = SDL_GetTicks();
+    if (state.stamina >= actualCost) {
+        state.stamina -= actualCost;
+        state.lastStaminaUseTick = now;
         return true;
     }
     return false;
@@ -458,7 +332,7 @@ bool Entity::consumeStamina(int amount) {
 
 // Marks the entity as dead and changes its color
 void Entity::die() {
-    isAlive = false;
+    state.isAlive = false;
     this->color = {100, 100, 100, 255};
 }
 
@@ -468,17 +342,17 @@ void Entity::die() {
 
 // Getters
 // Just return private values for display or logic
-std::string Entity::getName() const { return name; }
-SDL_Color Entity::getColor() const { return color; }
-int Entity::getX() const { return x; }
-int Entity::getY() const { return y; }
+Color Entity::getColor() const { return color; }
+int Entity::getX() const { return state.x; }
+int Entity::getY() const { return state.y; }
 int Entity::getRad() const { return rad; } // Radius (size)
 int Entity::getSightRadius() const { return sightRadius; } // Vision range
-Entity::State Entity::getCurrentState() const { return currentState; }
+Entity::State Entity::getCurrentState() const { return (State)state.currentState; }
+bool Entity::getIsCharging() const { return state.isCharging; }
 
 // Convert state Enum to String for the UI panel
 std::string Entity::getCurrentStateString() const {
-    switch (currentState) {
+    switch (getCurrentState()) {
         case WANDER: return "WANDER"; // Just walking around
         case COMBAT: return "COMBAT"; // Fighting
         case FLEE:   return "FLEE";   // Running away (low HP)
@@ -487,90 +361,68 @@ std::string Entity::getCurrentStateString() const {
     }
 }
 
-// Direct access to the DNA array
-const float* Entity::getGeneticCode() const { return geneticCode; }
-
 // Get specific genes by index
-float Entity::getKiteRatio() const { return geneticCode[2]; }   // Kiting distance
-float Entity::getWeaponGene() const { return geneticCode[1]; }  // Weapon type
+float Entity::getKiteRatio() const { return genome[2]; }   // Kiting distance
+float Entity::getWeaponGene() const { return genome[1]; }  // Weapon type
 bool Entity::getIsRanged() const { return getEntityType() == 1; } // Helper to check if ranged
-int Entity::getGeneration() const { return generation; }
 
-// get the parents for genealogy
-std::string Entity::getParent1Name() const { return parent1_name; }
-std::string Entity::getParent2Name() const { return parent2_name; }
+// Names are only built for display, identity is the EntityId
+std::string Entity::formatName(EntityId id, int generation) {
+    if (!id.isValid()) return "NONE";
+    return "G" + std::to_string(generation) + "-E" + std::to_string(id.index);
+}
 
 // Trait ID is stored as a float in the genes, cast it back to int
-int Entity::getCurrentTraitID() const { return (int)std::round(geneticCode[11]); }
+int Entity::getCurrentTraitID() const { return (int)std::round(genome[11]); }
 
-int Entity::getHealth() const { return health; }
-void Entity::setHealth(int h) { health = h; } // Useful for debug or reset
+int Entity::getHealth() const { return state.health; }
+void Entity::setHealth(int h) { state.health = h; } // Useful for debug or reset
 int Entity::getMaxHealth() const { return maxHealth; }
-int Entity::getStamina() const { return stamina; }
+int Entity::getStamina() const { return state.stamina; }
 
 int Entity::getMaxStamina() const { return maxStamina; }
-bool Entity::getIsAlive() const { return isAlive; }
+bool Entity::getIsAlive() const { return state.isAlive; }
 int Entity::getSpeed() const { return speed; }
 
 float Entity::getArmor() const { return armor; } // Damage reduction (0.0 to 1.0)
 int Entity::getDamage() const { return damage; }
 int Entity::getAttackRange() const { return attackRange; }
-Uint32 Entity::getAttackCooldown() const { return attackCooldown; }
+std::uint32_t Entity::getAttackCooldown() const { return attackCooldown; }
 int Entity::getProjectileSpeed() const { return projectileSpeed; }
 
 int Entity::getProjectileRadius() const { return projectileRadius; }
 int Entity::getStaminaAttackCost() const { return staminaAttackCost; }
 
 // Named getters to avoid "magic numbers" in the code
-float Entity::getDamageFragility() const { return geneticCode[3]; }
-float Entity::getStaminaEfficiency() const { return geneticCode[4]; }
-float Entity::getBaseHealthRegen() const { return geneticCode[5]; }
-float Entity::getMyopiaFactor() const { return geneticCode[6]; }
-float Entity::getAimingPenalty() const { return geneticCode[7]; }
-int Entity::getFertilityFactor() const { return (int)geneticCode[9]; }
-float Entity::getAgingRate() const { return geneticCode[8]; }
-float Entity::getBravery() const { return geneticCode[12]; } // Flee threshold
-float Entity::getGreed() const { return geneticCode[13]; }   // Hunger threshold
+float Entity::getDamageFragility() const { return genome[3]; }
+float Entity::getStaminaEfficiency() const { return genome[4]; }
+float Entity::getBaseHealthRegen() const { return genome[5]; }
+float Entity::getMyopiaFactor() const { return genome[6]; }
+float Entity::getAimingPenalty() const { return genome[7]; }
+int Entity::getFertilityFactor() const { return (int)genome[9]; }
+float Entity::getAgingRate() const { return genome[8]; }
+float Entity::getBravery() const { return genome[12]; } // Flee threshold
+float Entity::getGreed() const { return genome[13]; }   // Hunger threshold
 
 // --- Setters and Logic ---
-void Entity::setX(int newX) { x = newX; }
-void Entity::setY(int newY) { y = newY; }
+void Entity::setX(int newX) { state.x = newX; }
+void Entity::setY(int newY) { state.y = newY; }
 
 // Toggle booleans for animation/logic states
-void Entity::setIsFleeing(bool fleeing) { isFleeing = fleeing; }
-void Entity::setIsCharging(bool charging) { isCharging = charging; }
+void Entity::setIsFleeing(bool fleeing) { state.isFleeing = fleeing; }
+void Entity::setIsCharging(bool charging) { state.isCharging = charging; }
 
-void Entity::setCurrentState(State s) { currentState = s; }
+void Entity::setCurrentState(State s) { state.currentState = (std::uint8_t)s; }
 
 // Healing function (caps at max health)
 void Entity::receiveHealing(int amount) {
-    if (!isAlive) return; // Dead entities can't heal
-    health += amount;
-    if (health > maxHealth) health = maxHealth;
+    if (!state.isAlive) return; // Dead entities can't heal
+    state.health += amount;
+    if (state.health > maxHealth) state.health = maxHealth;
 }
 
-// Check if allied based on color similarity
-bool Entity::isAlliedWith(const Entity& other) const {
-    // Calculate difference for R, G, B
-    int dr = std::abs(color.r - other.color.r);
-    int dg = std::abs(color.g - other.color.g);
-    int db = std::abs(color.b - other.color.b);
-
-    // If total difference is low (< 30), they are family/friends
-    return (dr + dg + db) < 30;
+// Restore stamina (eating)
+void Entity::restoreStamina(int amount) {
+    state.stamina += amount;
+    if (state.stamina > maxStamina) state.stamina = maxStamina;
 }
-
-// Restore stamina (eating) + Visual feedback
-void Entity::restoreStamina(int amount, int speedMultiplier) {
-    stamina += amount;
-    if (stamina > maxStamina) stamina = maxStamina;
-
-    // Calculate white flash duration
-    // Divide by speedMultiplier so the flash isn't too long in x100 speed
-    int duration = 10 / (speedMultiplier > 0 ? speedMultiplier : 1);
-
-    // Safety: at least 1 frame of flash
-    if (duration < 1) duration = 1;
-
-    flashTimer = duration; // Set the timer used in draw()
-}
\ No newline at end of file
@@ -1,20 +1,41 @@
 #ifndef EVOARENA_ENTITY_H
 #define EVOARENA_ENTITY_H
 
-#include <SDL2/SDL.h>
-#include <SDL2/SDL2_gfxPrimitives.h>
-#include <SDL2/SDL_image.h>
 #include "../constants.h"
+#include "../core/SimClock.h"
+#include "../core/Random.h"
+#include "EntityId.h"
+#include "Genome.h"
 #include <algorithm>
 #include <string>
 #include <cstdlib>
-#include <map>
+#include <cstdint>
 #include <cmath>
-#include <iostream>
+#include <type_traits>
 
-class Projectile;
+struct TraitStats;
 
-// Represents an entity in the game, including its stats, behavior, and rendering
+// Per-tick state of an entity: everything the update reads and writes every tick, packed to
+// fit one cache line. The derived stats and the genome are only read after creation.
+struct EntityState {
+    int x = 0, y = 0;
+    int health = 0;
+    int stamina = 0;
+    int direction[2]{};         // Point the entity is walking to (0, 0 = none)
+    float lastVelX = 1.0f;
+    float lastVelY = 0.0f;
+    SimTick lastRegenTick = 0;
+    SimTick lastStaminaUseTick = 0;
+    SimTick lastAttackTick = -1000000;
+    std::uint8_t currentState = 0;  // Entity::State
+    bool isAlive = true;
+    bool isFleeing = false;
+    bool isCharging = false;
+};
+
+static_assert(sizeof(EntityState) <= 64, "EntityState must fit in one cache line");
+
+// Represents an entity in the game, including its stats and behavior
 class Entity {
 public:
     // Possible states for the entity
@@ -25,72 +46,73 @@ public:
         FORAGE
     };
 
-    // Constructor and destructor
-    Entity(std::string name, int x, int y, SDL_Color color,
-           const float geneticCode[12], int generation,
-           std::string parent1_name, std::string parent2_name);
-    ~Entity();
+    // Combat roles, as returned by getEntityType()
+    enum Role {
+        MELEE = 0,
+        RANGED = 1,
+        HEALER = 2,
+        ROLE_COUNT = 3
+    };
+
+    // Constructor (rng draws the initial heading and regen phase).
+    // Entities are trivially copyable: lineage and display-only data live in Simulation's side tables
+    Entity(EntityId id, int x, int y, Color color, const Genome& genome, RandomStream& rng);
 
-    // Updates the entity's state
-    void update(int speedMultiplier);
+    // Empty slot, only used to presize buffers that are then overwritten (parallel reproduction)
+    Entity() = default;
 
-    // Renders the entity on the screen
-    void draw(SDL_Renderer* renderer, const Camera& cam, bool showDebug = false);
+    // Updates the entity's state for one fixed-length tick
+    void update(SimTick now, RandomStream& rng);
 
-    // Chooses a new direction for movement
-    void chooseDirection(int target[2] = nullptr);
+    // Chooses a new direction for movement (rng drives the wander jitter when target is null)
+    void chooseDirection(RandomStream& rng, int target[2] = nullptr);
 
     // Applies a knockback effect
     void knockBackFrom(int sourceX, int sourceY, int force);
 
 
 
-    // Determines the entity type (Melee, Ranged, or Healer)
-    int getEntityType() const {
-        float val = geneticCode[10];
-        if (val < 0.33f) return 0; // Melee
-        if (val < 0.66f) return 1; // Ranged
-        return 2;                  // Healer
-    }
+    // Entity type (Melee, Ranged, or Healer), resolved from the role gene in calculateDerivedStats
+    int getEntityType() const { return entityType; }
 
     // Heals the entity
     void receiveHealing(int amount);
 
-    // Checks if another entity is an ally
-    bool isAlliedWith(const Entity& other) const;
+    // Checks if another entity is an ally (same clan)
+    bool isAlliedWith(const Entity& other) const { return clanId == other.clanId; }
 
-    // Clears the current movement target
-    void clearTarget() { targetX = -1; targetY = -1; }
+    // Clan of the entity, resolved from its color once per generation by Simulation
+    int getClanId() const { return clanId; }
+    void setClanId(int clan) { clanId = clan; }
 
     // Setters for position and state
     void setX(int newX);
     void setY(int newY);
     void die();
     void takeDamage(int amount);
-    bool consumeStamina(int amount);
+    bool consumeStamina(int amount, SimTick now);
     void setIsFleeing(bool fleeing);
     void setIsCharging(bool charging);
     void setCurrentState(State s);
 
     // Getters for basic properties
-    [[nodiscard]] std::string getName() const;
-    SDL_Color getColor() const;
+    EntityId getId() const { return id; }
+    Color getColor() const;
     int getX() const;
     int getY() const;
     int getRad() const;
     int getSightRadius() const;
     State getCurrentState() const;
+    bool getIsCharging() const;
     std::string getCurrentStateString() const;
 
     // Getters for genetic code
-    const float* getGeneticCode() const;
+    const Genome& getGenome() const { return genome; }
     float getKiteRatio() const;
     float getWeaponGene() const;
     bool getIsRanged() const;
-    int getGeneration() const;
-    std::string getParent1Name() const;
-    std::string getParent2Name() const;
     int getCurrentTraitID() const;
+    const TraitStats& getTraitStats() const { return *traitStats; }  // Resolved in calculateDerivedStats
 
     // Getters for derived stats
     int getHealth() const;
@@ -103,7 +125,7 @@ public:
     float getArmor() const;
     int getDamage() const;
     int getAttackRange() const;
-    Uint32 getAttackCooldown() const;
+    std::uint32_t getAttackCooldown() const;
     int getProjectileSpeed() const;
     int getProjectileRadius() const;
     int getStaminaAttackCost() const;
@@ -120,68 +142,60 @@ public:
     float getGreed() const;
 
     // Generates a random color
-    static SDL_Color generateRandomColor();
+    static Color generateRandomColor(RandomStream& rng);
 
-    // Restores stamina and triggers a flash effect
-    void restoreStamina(int amount, int speedMultiplier);
+    // Stable key of the entity's random streams
+    std::uint64_t getRngKey() const { return id.packed(); }
 
-private:
-    // Calculates derived stats based on genetic code and traits
-    void calculateDerivedStats();
+    // Display name of an entity ("G<generation>-E<index>", "NONE" for an invalid id)
+    static std::string formatName(EntityId id, int generation);
 
+    // Attack cooldown, owned by the entity so that only its updating worker reads or writes it
+    bool isAttackReady(SimTick now) const { return now - state.lastAttackTick >= msToTicks(attackCooldown); }
+    void markAttack(SimTick now) { state.lastAttackTick = now; }
 
+    // Restores stamina (eating)
+    void restoreStamina(int amount);
 
+private:
+    // Calculates derived stats based on genetic code and traits
+    void calculateDerivedStats();
 
-    // Constants for stamina and health regeneration
-    static constexpr Uint32 REGEN_COOLDOWN_MS = 2000;
-    static constexpr Uint32 STAMINA_REGEN_DELAY_MS = 3000;
+    // Constants for stamina and health regeneration (timers in ticks)
+    static constexpr SimTick REGEN_COOLDOWN_TICKS = msToTicks(2000);
+    static constexpr SimTick STAMINA_REGEN_DELAY_TICKS = msToTicks(3000);
+    static constexpr SimTick STAMINA_DRAIN_INTERVAL_TICKS = 2;
     static constexpr int STAMINA_REGEN_RATE = 1;
     static constexpr int STAMINA_FLEE_COST_PER_FRAME = 4;
     static constexpr int STAMINA_CHARGE_COST_PER_FRAME = 3;
 
-    // Entity properties
-    std::string name;
-    int x, y;
-    bool isAlive = true;
-    SDL_Color color;
-    int rad;
-    float geneticCode[14];
+    // Hot state, first so that it shares the object's first cache line
+    EntityState state;
 
-    // State and stats
-    State currentState = WANDER;
-    int health;
+    // Identity
+    EntityId id;
+    Color color;
+    int clanId = 0;
+
+    // Stats derived from the genome and the trait (set by calculateDerivedStats)
+    int rad;
+    int entityType = MELEE;
+    const TraitStats* traitStats = nullptr; // Entry of the trait table (tables are never freed)
     int maxHealth;
     int speed;
     int sightRadius;
-    int stamina;
     int maxStamina;
     int damage;
     int attackRange;
-    Uint32 attackCooldown;
+    std::uint32_t attackCooldown;
     int projectileSpeed;
     int projectileRadius;
     int staminaAttackCost;
     float armor = 0.0f;
-    int regenAmount = 0;
 
-    // Movement and behavior
-    int direction[2]{};
-    int targetX = -1;
-    int targetY = -1;
-    float lastVelX = 1.0f;
-    float lastVelY = 0.0f;
-    Uint32 lastRegenTick = 0;
-    Uint32 lastStaminaUseTick = 0;
-    bool isFleeing = false;
-    bool isCharging = false;
-
-    // Metadata
-    int generation;
-    std::string parent1_name;
-    std::string parent2_name;
-
-    //ajout du timer effacé par mégarde
-    int flashTimer = 0;
+    Genome genome;
 };
 
+static_assert(std::is_trivially_copyable_v<Entity>, "Entity copies (survivors, archive, inspection) must stay memcpys");
+
 #endif //EVOARENA_ENTITY_H
@@ -0,0 +1,23 @@
+#ifndef EVOARENA_ENTITYID_H
+#define EVOARENA_ENTITYID_H
+
+#include <cstdint>
+#include <compare>
+
+// Compact identity of an entity: its birth order inside a population and the epoch
+// (Simulation::getPopulationEpoch) of that population as a generation tag. The tag keeps
+// an id from matching an entity of a later population that reused the same index.
+// Index 0 is reserved for "no entity" (e.g. the parents of generation 0).
+struct EntityId {
+    std::uint32_t index = 0;
+    std::uint32_t tag = 0;
+
+    bool isValid() const { return index != 0; }
+
+    // Both words in one integer (stream keys, hashing)
+    std::uint64_t packed() const { return ((std::uint64_t)tag << 32) | index; }
+
+    auto operator<=>(const EntityId&) const = default;
+};
+
+#endif //EVOARENA_ENTITYID_H
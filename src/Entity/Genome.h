@@ -0,0 +1,22 @@
+#ifndef EVOARENA_GENOME_H
+#define EVOARENA_GENOME_H
+
+#include <type_traits>
+
+// The genes of an entity, as a plain value type: copying a genome (or an entity) is a memcpy.
+// Gene indices: 0 size, 1 weapon, 2 kite distance, 3 fragility, 4 stamina efficiency,
+// 5 health regen, 6 myopia, 7 aiming penalty, 8 aging, 9 fertility, 10 role, 11 trait ID,
+// 12 bravery, 13 greed.
+struct Genome {
+    static constexpr int GENE_COUNT = 14;
+
+    float genes[GENE_COUNT]{};
+
+    float& operator[](int i) { return genes[i]; }
+    float operator[](int i) const { return genes[i]; }
+    const float* data() const { return genes; }
+};
+
+static_assert(std::is_trivially_copyable_v<Genome>, "Genome must stay a plain value type");
+
+#endif //EVOARENA_GENOME_H
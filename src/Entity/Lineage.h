@@ -0,0 +1,14 @@
+#ifndef EVOARENA_LINEAGE_H
+#define EVOARENA_LINEAGE_H
+
+#include "EntityId.h"
+
+// Genealogy of an entity. Only reproduction bookkeeping and the inspection panel read it, so it
+// lives in a side table of Simulation rather than in the Entity itself.
+struct Lineage {
+    int generation = 0;
+    EntityId parent1;       // Invalid for the founders of generation 0
+    EntityId parent2;
+};
+
+#endif //EVOARENA_LINEAGE_H
@@ -5,19 +5,35 @@
 
     using json = nlohmann::json;
 
+    namespace {
+        // Table holding only the "Classique" trait, current until a file is loaded
+        std::vector<TraitStats> makeClassiqueTable() {
+            TraitStats classique;
+            classique.name = "Classique";
+            classique.description = "Neutral";
+            return {classique};
+        }
+    }
+
     // Static member initialization
-    std::map<int, TraitStats> TraitManager::traitDatabase;
+    std::vector<std::unique_ptr<TraitManager::Table>> TraitManager::tables;
+    const TraitManager::Table* TraitManager::table = [] {
+        tables.push_back(std::make_unique<Table>(makeClassiqueTable()));
+        return tables.back().get();
+    }();
+    std::string TraitManager::loadedPath;
+    std::filesystem::file_time_type TraitManager::loadedTime;
     TraitStats TraitManager::defaultTrait;
 
     // Load traits from a JSON file
     void TraitManager::loadTraits(const std::string& filepath) {
-        traitDatabase.clear();
+        // Skip the parse if this exact file was already loaded
+        std::error_code error;
+        std::filesystem::file_time_type fileTime = std::filesystem::last_write_time(filepath, error);
+        if (!error && filepath == loadedPath && fileTime == loadedTime) return;
 
         // Add a default "Classique" trait (ID 0) manually, as it may not exist in the JSON file
-        TraitStats classique;
-        classique.name = "Classique";
-        classique.description = "Neutral";
-        traitDatabase[0] = classique;
+        auto newTable = std::make_unique<Table>(makeClassiqueTable());
 
         // Open the JSON file
         std::ifstream file(filepath);
@@ -55,16 +71,16 @@
                 stats.staminaRegenBonus = s.value("staminaRegenBonus", 0.0f);
             }
 
-            // Add the trait to the database
-            traitDatabase[id] = stats;
+            // Add the trait to the table (IDs are expected to be dense; gaps keep the default trait)
+            if (id < 0) continue;
+            if (id >= (int)newTable->size()) newTable->resize(id + 1);
+            (*newTable)[id] = stats;
             std::cout << "[TraitManager] Loaded ID " << id << ": " << stats.name << std::endl;
         }
-    }
 
-    // Retrieve a trait by its ID, or return the default trait if not found
-    const TraitStats& TraitManager::get(int id) {
-        if (traitDatabase.find(id) != traitDatabase.end()) {
-            return traitDatabase[id];
-        }
-        return defaultTrait;
+        // Publish the new table; the previous ones stay alive for the entities pointing into them
+        tables.push_back(std::move(newTable));
+        table = tables.back().get();
+        loadedPath = filepath;
+        loadedTime = fileTime;
     }
\ No newline at end of file
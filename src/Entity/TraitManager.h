@@ -2,8 +2,9 @@
     #define TRAITMANAGER_H
 
     #include <string>
-    #include <map>
     #include <vector>
+    #include <memory>
+    #include <filesystem>
 
     // Represents the statistics associated with a trait
     struct TraitStats {
@@ -25,16 +26,32 @@
         float damageTakenMult = 1.0f;          // Damage taken multiplier
     };
 
-    // Manages the loading and retrieval of traits
+    // Manages the loading and retrieval of traits.
+    // Traits are compiled into a contiguous, immutable table indexed by their dense ID. A loaded
+    // table is never modified or freed: entities keep pointers into it, so a reload builds a new
+    // table and retires the old one instead.
     class TraitManager {
     public:
-        static void loadTraits(const std::string& filepath); // Load traits from a file
-        static const TraitStats& get(int id);               // Retrieve a trait by ID
-        static int getCount() { return (int)traitDatabase.size(); } // Get the total number of traits
+        // Load traits from a file. The JSON is only parsed again if the path or the file's
+        // modification time changed since the last load
+        static void loadTraits(const std::string& filepath);
+
+        // Retrieve a trait by ID (the default trait for an unknown ID)
+        static const TraitStats& get(int id) {
+            return (id >= 0 && id < (int)table->size()) ? (*table)[id] : defaultTrait;
+        }
+
+        // Get the total number of traits (IDs 0 to count - 1)
+        static int getCount() { return (int)table->size(); }
 
     private:
-        static std::map<int, TraitStats> traitDatabase;     // Database of traits
-        static TraitStats defaultTrait;                    // Default trait for fallback
+        using Table = std::vector<TraitStats>;
+
+        static const Table* table;                          // Current table
+        static std::vector<std::unique_ptr<Table>> tables;  // Every table loaded so far (the last one is current)
+        static std::string loadedPath;                      // Source of the current table
+        static std::filesystem::file_time_type loadedTime;  // Modification time of that source when parsed
+        static TraitStats defaultTrait;                     // Default trait for fallback
     };
 
     #endif
\ No newline at end of file
@@ -0,0 +1,354 @@
+#include "SimulationView.h"
+#include "Entity/TraitManager.h"
+#include <SDL2/SDL2_gfxPrimitives.h>
+#include <cmath>
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+    // Width of the inspection panel
+    const int PANEL_WIDTH = 300;
+
+    // Duration of the white flash after a meal
+    const SimTick FLASH_TICKS = 10;
+}
+
+// Constructor: Starts with the inspection panel hidden off-screen
+SimulationView::SimulationView() {
+    reset();
+}
+
+// Drops the selection and hides the panel (used when a new simulation starts)
+void SimulationView::reset() {
+    selectedLivingEntity = nullptr;
+    selectedId = EntityId{};
+    inspectionStack.clear();
+    observedEpoch = -1;
+    previousFrameTick = 0;
+    currentFrameTick = 0;
+    panelCurrentX = (float)WINDOW_WIDTH;
+    panelTargetX = (float)WINDOW_WIDTH;
+}
+
+// Re-resolves the selection against the current population and animates the panel
+void SimulationView::update(const Simulation& sim) {
+    previousFrameTick = currentFrameTick;
+    currentFrameTick = sim.getCurrentTick();
+
+    // The population was replaced: the inspected entities no longer exist
+    if (sim.getPopulationEpoch() != observedEpoch) {
+        observedEpoch = sim.getPopulationEpoch();
+        selectedLivingEntity = nullptr;
+        selectedId = EntityId{};
+        inspectionStack.clear();
+    }
+
+    // Entities may have moved in memory (dead ones are compacted away), so look the selection up again
+    selectedLivingEntity = nullptr;
+    if (selectedId.isValid()) {
+        for (const auto& entity : sim.getEntities()) {
+            if (entity.getIsAlive() && entity.getId() == selectedId) { selectedLivingEntity = &entity; break; }
+        }
+    }
+
+    // UI animation
+    if (!inspectionStack.empty()) panelTargetX = (float)(WINDOW_WIDTH - PANEL_WIDTH); else panelTargetX = (float)WINDOW_WIDTH;
+    float distance = panelTargetX - panelCurrentX;
+    if (std::abs(distance) < 1.0f) panelCurrentX = panelTargetX; else panelCurrentX += distance * 0.1f;
+}
+
+// Handles user input events
+void SimulationView::handleEvent(const SDL_Event &event, const Camera& cam, const Simulation& sim) {
+    if (event.type == SDL_MOUSEBUTTONDOWN && event.button.button == SDL_BUTTON_LEFT) {
+        int mouseX = event.button.x;
+        int mouseY = event.button.y;
+        SDL_Point mousePoint = {mouseX, mouseY};
+
+        // Handle clicks on the UI panel
+        if (!inspectionStack.empty() && mouseX > panelCurrentX) {
+            if (SDL_PointInRect(&mousePoint, &panelBack_rect) && inspectionStack.size() > 1) inspectionStack.pop_back();
+            else if (SDL_PointInRect(&mousePoint, &panelParent1_rect)) {
+                const Entity* parent1 = sim.findArchivedEntity(inspectionStack.back().lineage.parent1);
+                if (parent1) inspect(*parent1, sim);
+            } else if (SDL_PointInRect(&mousePoint, &panelParent2_rect)) {
+                const Entity* parent2 = sim.findArchivedEntity(inspectionStack.back().lineage.parent2);
+                if (parent2) inspect(*parent2, sim);
+            }
+            return;
+        }
+
+        // Handle clicks in the world (entity selection)
+        float worldMouseX = mouseX / cam.zoom + cam.x;
+        float worldMouseY = mouseY / cam.zoom + cam.y;
+        bool entityClicked = false;
+        for (const auto& entity : sim.getEntities()) {
+            if (!entity.getIsAlive()) continue;
+            int dx = worldMouseX - entity.getX();
+            int dy = worldMouseY - entity.getY();
+            if (std::sqrt((float)dx*dx + dy*dy) < entity.getRad()) {
+                selectedLivingEntity = &entity;
+                selectedId = entity.getId();
+                inspectionStack.clear();
+                inspect(entity, sim);
+                entityClicked = true;
+                break;
+            }
+        }
+        if (!entityClicked) { selectedLivingEntity = nullptr; selectedId = EntityId{}; inspectionStack.clear(); }
+    }
+}
+
+// Pushes the entity on the inspection stack with its lineage
+void SimulationView::inspect(const Entity& entity, const Simulation& sim) {
+    const Lineage* lineage = sim.findLineage(entity.getId());
+    inspectionStack.push_back({entity, lineage ? *lineage : Lineage{}});
+}
+
+// Renders the simulation, including entities, projectiles, and UI
+void SimulationView::render(SDL_Renderer* renderer, const Simulation& sim, bool showDebug, const Camera& cam) {
+    for (const auto& f : sim.getFoods().getItems()) {
+        float sx = (f.x - cam.x) * cam.zoom;
+        float sy = (f.y - cam.y) * cam.zoom;
+        float sr = f.radius * cam.zoom;
+        filledCircleRGBA(renderer, (int)sx, (int)sy, (int)sr, 34, 139, 34, 255);
+        circleRGBA(renderer, (int)sx, (int)sy, (int)sr, 144, 238, 144, 200);
+    }
+    for (const auto &entity : sim.getEntities()) drawEntity(renderer, entity, sim.getCurrentTick(), sim.getLastFeedTick(entity.getId()), cam, showDebug);
+    const ProjectilePool& projectiles = sim.getProjectiles();
+    for (int i = 0; i < projectiles.size(); ++i) drawProjectile(renderer, projectiles, i, cam);
+
+    if (selectedLivingEntity != nullptr) {
+        float sx = (selectedLivingEntity->getX() - cam.x) * cam.zoom;
+        float sy = (selectedLivingEntity->getY() - cam.y) * cam.zoom;
+        float sr = (selectedLivingEntity->getRad() + 4) * cam.zoom;
+        circleRGBA(renderer, (int)sx, (int)sy, (int)sr, 255, 255, 0, 200);
+    }
+
+    if (panelCurrentX < WINDOW_WIDTH) drawStatsPanel(renderer, static_cast<int>(panelCurrentX));
+}
+
+// Draws an entity on the screen, including debug visuals and health/stamina bars
+void SimulationView::drawEntity(SDL_Renderer* renderer, const Entity& entity, SimTick currentTick, SimTick lastFeed, const Camera& cam, bool showDebug) {
+    const Color color = entity.getColor();
+
+    // Transform camera coordinates
+    int screenX = (int)((entity.getX() - cam.x) * cam.zoom);
+    int screenY = (int)((entity.getY() - cam.y) * cam.zoom);
+    int screenRad = (int)(entity.getRad() * cam.zoom);
+
+    // Skip drawing if off-screen
+    if (screenX + screenRad < 0 || screenX - screenRad > WINDOW_WIDTH ||
+        screenY + screenRad < 0 || screenY - screenRad > WINDOW_HEIGHT) {
+        return;
+    }
+
+    // Flash effect when eating (a meal since the previous frame always shows, even at high speed)
+    if (currentTick - lastFeed < FLASH_TICKS || lastFeed >= previousFrameTick) {
+        filledCircleRGBA(renderer, screenX, screenY, screenRad, 255, 255, 255, 255);
+    } else {
+        // Draw entity based on type
+        int type = entity.getEntityType();
+
+        if (type == 1) {
+            // Ranged
+            filledCircleRGBA(renderer, screenX, screenY, screenRad, color.r, color.g, color.b, 255);
+            filledCircleRGBA(renderer, screenX, screenY, (int)(screenRad * 0.65f), 20, 20, 20, 255);
+            filledCircleRGBA(renderer, screenX, screenY, (int)(screenRad * 0.30f), color.r, color.g, color.b, 255);
+            circleRGBA(renderer, screenX, screenY, (int)(screenRad * 0.35f), 255, 255, 255, 100);
+        } else if (type == 2) {
+            // Healer
+            filledCircleRGBA(renderer, screenX, screenY, screenRad, color.r, color.g, color.b, 255);
+
+            Uint8 r_dark = (Uint8)(color.r * 0.7f);
+            Uint8 g_dark = (Uint8)(color.g * 0.7f);
+            Uint8 b_dark = (Uint8)(color.b * 0.7f);
+            circleRGBA(renderer, screenX, screenY, screenRad, r_dark, g_dark, b_dark, 255);
+
+            int w = (int)(screenRad * 0.5f);
+            int t = (int)(screenRad * 0.2f);
+            boxRGBA(renderer, screenX - w, screenY - t, screenX + w, screenY + t, 40, 40, 40, 255);
+            boxRGBA(renderer, screenX - t, screenY - w, screenX + t, screenY + w, 40, 40, 40, 255);
+
+            rectangleRGBA(renderer, screenX - w, screenY - t, screenX + w, screenY + t, 255, 255, 255, 100);
+            rectangleRGBA(renderer, screenX - t, screenY - w, screenX + t, screenY + w, 255, 255, 255, 100);
+        } else {
+            // Melee
+            Uint8 r_dark = (Uint8)(color.r * 0.6f);
+            Uint8 g_dark = (Uint8)(color.g * 0.6f);
+            Uint8 b_dark = (Uint8)(color.b * 0.6f);
+            filledCircleRGBA(renderer, screenX, screenY, screenRad, r_dark, g_dark, b_dark, 255);
+            filledCircleRGBA(renderer, screenX, screenY, (int)(screenRad * 0.75f), color.r, color.g, color.b, 255);
+        }
+    }
+
+    // Debug visuals
+    if (showDebug) {
+        int screenSight = (int)(entity.getSightRadius() * cam.zoom);
+        circleRGBA(renderer, screenX, screenY, screenSight, 255, 255, 255, 50);
+        if (entity.getIsCharging()) {
+            circleRGBA(renderer, screenX, screenY, screenRad + 3, 255, 50, 50, 255);
+        }
+        stringRGBA(renderer, screenX - (int)(0.1 * screenRad), screenY - (int)(0.1 * screenRad), std::to_string(entity.getHealth()).c_str(), 255, 255, 255, 255);
+    }
+
+    // Health and stamina bars
+    int barWidth = (int)(6 * cam.zoom);
+    if (barWidth < 2) barWidth = 2;
+    int barHeight = 2 * screenRad;
+    int offset = screenRad + barWidth + 2;
+
+    float healthPercent = std::clamp((float)entity.getHealth() / (float)entity.getMaxHealth(), 0.0f, 1.0f);
+    float staminaPercent = std::clamp((float)entity.getStamina() / (float)entity.getMaxStamina(), 0.0f, 1.0f);
+
+    // Health bar
+    SDL_Rect healthBarBg = {screenX - offset - barWidth, screenY - barHeight / 2, barWidth, barHeight};
+    SDL_SetRenderDrawColor(renderer, 40, 40, 40, 255);
+    SDL_RenderFillRect(renderer, &healthBarBg);
+
+    int healthFillHeight = static_cast<int>(barHeight * healthPercent + 0.5f);
+    if (healthFillHeight > 0) {
+        SDL_Rect healthBar = {screenX - offset - barWidth, screenY + barHeight / 2 - healthFillHeight, barWidth, healthFillHeight};
+        SDL_SetRenderDrawColor(renderer, 220, 20, 20, 255);
+        SDL_RenderFillRect(renderer, &healthBar);
+    }
+
+    // Stamina bar
+    SDL_Rect staminaBarBg = {screenX + offset, screenY - barHeight / 2, barWidth, barHeight};
+    SDL_SetRenderDrawColor(renderer, 40, 40, 40, 255);
+    SDL_RenderFillRect(renderer, &staminaBarBg);
+
+    int staminaFillHeight = static_cast<int>(barHeight * staminaPercent + 0.5f);
+    if (staminaFillHeight > 0) {
+        SDL_Rect staminaBar = {screenX + offset, screenY + barHeight / 2 - staminaFillHeight, barWidth, staminaFillHeight};
+        SDL_SetRenderDrawColor(renderer, 20, 100, 255, 255);
+        SDL_RenderFillRect(renderer, &staminaBar);
+    }
+}
+
+// Renders a projectile on the screen if it is still active
+void SimulationView::drawProjectile(SDL_Renderer* renderer, const ProjectilePool& projectiles, int i, const Camera& cam) {
+    if (projectiles.isAlive(i)) {
+        float sx = ((int)projectiles.getX(i) - cam.x) * cam.zoom; // Adjust position based on camera
+        float sy = ((int)projectiles.getY(i) - cam.y) * cam.zoom;
+        float sr = projectiles.getRadius(i) * cam.zoom;         // Adjust radius based on camera zoom
+        Color color = projectiles.getColor(i);
+        filledCircleRGBA(renderer, (int)sx, (int)sy, (int)sr, color.r, color.g, color.b, 255);
+    }
+}
+
+// Draws the stats panel for the selected entity
+void SimulationView::drawStatsPanel(SDL_Renderer* renderer, int panelX) {
+    auto float_to_string = [](float val, int precision = 1) {
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(precision) << val;
+        return ss.str();
+    };
+
+    if (inspectionStack.empty()) return;
+
+    const Entity* entityToDisplay = (inspectionStack.size() == 1 && selectedLivingEntity) ? selectedLivingEntity : &inspectionStack.back().entity;
+    if (!entityToDisplay) return;
+    const Entity& entity = *entityToDisplay;
+    const Lineage& lineage = inspectionStack.back().lineage;
+
+    SDL_Rect panelRect = {panelX, 0, PANEL_WIDTH, WINDOW_HEIGHT};
+    SDL_SetRenderDrawColor(renderer, 20, 20, 20, 240);
+    SDL_RenderFillRect(renderer, &panelRect);
+
+    int x = panelX + 15;
+    int y = 20;
+    const int lineHeight = 18;
+
+    SDL_Color titleColor  = {255, 215, 0, 255};
+    SDL_Color statColor   = {220, 220, 220, 255};
+    SDL_Color geneColor   = {100, 200, 255, 255};
+    SDL_Color linkColor   = {80, 80, 255, 255};
+    SDL_Color badColor    = {255, 100, 100, 255};
+    SDL_Color goodColor   = {100, 255, 100, 255};
+    SDL_Color stateColor  = {255, 165, 0, 255};
+
+    if (inspectionStack.size() > 1) {
+        stringRGBA(renderer, x + 10, y + 8, "< Back", statColor.r, statColor.g, statColor.b, 255);
+        panelBack_rect = {x, y, 80, 25};
+        rectangleRGBA(renderer, panelBack_rect.x, panelBack_rect.y, panelBack_rect.x+panelBack_rect.w, panelBack_rect.y+panelBack_rect.h, 255,255,255,100);
+        y += 40;
+    } else {
+        panelBack_rect = {0,0,0,0};
+    }
+
+    stringRGBA(renderer, x, y, ("ID: " + Entity::formatName(entity.getId(), lineage.generation)).c_str(), titleColor.r, titleColor.g, titleColor.b, 255); y += lineHeight*1.5;
+
+    std::string hpStr = entityToDisplay == selectedLivingEntity ? std::to_string(entity.getHealth()) : "(Decede)";
+    stringRGBA(renderer, x, y, ("Health: " + hpStr + " / " + std::to_string(entity.getMaxHealth())).c_str(), statColor.r, statColor.g, statColor.b, 255); y += lineHeight;
+    stringRGBA(renderer, x, y, ("Stamina: " + std::to_string(entity.getStamina())).c_str(), statColor.r, statColor.g, statColor.b, 255); y += lineHeight*1.5;
+    stringRGBA(renderer, x, y, ("CURRENT STATE: " + entity.getCurrentStateString()).c_str(), stateColor.r, stateColor.g, stateColor.b, 255);
+    y += lineHeight * 1.5;
+
+    stringRGBA(renderer, x, y, "--- Psychology ---", geneColor.r, geneColor.g, geneColor.b, 255); y += lineHeight;
+    stringRGBA(renderer, x, y, ("Bravery (Flee thresh): " + float_to_string(entity.getBravery() * 100, 0) + "%").c_str(), statColor.r, statColor.g, statColor.b, 255); y += lineHeight;
+    stringRGBA(renderer, x, y, ("Greed (Eat thresh): " + float_to_string(entity.getGreed() * 100, 0) + "%").c_str(), statColor.r, statColor.g, statColor.b, 255); y += lineHeight * 1.5;
+
+    stringRGBA(renderer, x, y, "--- Genealogie ---", geneColor.r, geneColor.g, geneColor.b, 255); y += lineHeight;
+    stringRGBA(renderer, x, y, ("Gen: " + std::to_string(lineage.generation)).c_str(), geneColor.r, geneColor.g, geneColor.b, 255); y += lineHeight;
+    stringRGBA(renderer, x, y, ("P1: " + Entity::formatName(lineage.parent1, lineage.generation - 1)).c_str(), linkColor.r, linkColor.g, linkColor.b, 255);
+    panelParent1_rect = {x, y - 2, 250, lineHeight}; y += lineHeight;
+    stringRGBA(renderer, x, y, ("P2: " + Entity::formatName(lineage.parent2, lineage.generation - 1)).c_str(), linkColor.r, linkColor.g, linkColor.b, 255);
+    panelParent2_rect = {x, y - 2, 250, lineHeight}; y += lineHeight*1.5;
+
+    stringRGBA(renderer, x, y, "--- Body Stats ---", statColor.r, statColor.g, statColor.b, 255); y += lineHeight;
+    std::string typeStr = "Melee";
+    int eType = entity.getEntityType();
+    if(eType == 1) typeStr = "Ranged"; else if(eType == 2) typeStr = "Healer";
+    stringRGBA(renderer, x, y, ("Type: " + typeStr).c_str(), geneColor.r, geneColor.g, geneColor.b, 255); y += lineHeight;
+    stringRGBA(renderer, x, y, ("Rad (Size): " + std::to_string(entity.getRad())).c_str(), statColor.r, statColor.g, statColor.b, 255); y += lineHeight;
+    stringRGBA(renderer, x, y, ("Speed: " + std::to_string(entity.getSpeed())).c_str(), statColor.r, statColor.g, statColor.b, 255); y += lineHeight;
+    stringRGBA(renderer, x, y, ("Armor: " + float_to_string(entity.getArmor()*100) + "%").c_str(), statColor.r, statColor.g, statColor.b, 255); y += lineHeight*1.5;
+
+    stringRGBA(renderer, x, y, "--- Bio-Traits ---", geneColor.r, geneColor.g, geneColor.b, 255); y += lineHeight;
+    int traitID = entity.getCurrentTraitID();
+    const TraitStats& stats = entity.getTraitStats();
+    std::string fullTraitTitle = stats.name;
+    if (entity.getDamageFragility() > 0.10f) fullTraitTitle += " / Weak";
+    if (entity.getMyopiaFactor() > 0.15f)    fullTraitTitle += " / Myopic";
+    if (entity.getFertilityFactor() > 0)     fullTraitTitle += " / Fertile";
+    if (entity.getAgingRate() > 0.0001f)     fullTraitTitle += " / Decaying";
+    if (entity.getAimingPenalty() > 2.0f)    fullTraitTitle += " / Clumsy";
+
+    stringRGBA(renderer, x, y, ("Trait: " + fullTraitTitle).c_str(), titleColor.r, titleColor.g, titleColor.b, 255); y += lineHeight;
+
+    if (traitID != 0 && !stats.description.empty()) {
+        stringRGBA(renderer, x, y, stats.description.c_str(), statColor.r, statColor.g, statColor.b, 255);
+        y += lineHeight;
+    }
+    y += 5;
+    float frag = entity.getDamageFragility() * 100.0f;
+    if(frag > 1.0f) {
+        stringRGBA(renderer, x, y, ("(Weak) Dmg Taken: +" + float_to_string(frag,1) + "%").c_str(), badColor.r, badColor.g, badColor.b, 255);
+        y += lineHeight;
+    }
+    float myop = entity.getMyopiaFactor() * 100.0f;
+    if(myop > 1.0f) {
+        stringRGBA(renderer, x, y, ("(Myopic) Vision: -" + float_to_string(myop,1) + "%").c_str(), badColor.r, badColor.g, badColor.b, 255);
+        y += lineHeight;
+    }
+    int fert = entity.getFertilityFactor();
+    if(fert > 0) {
+        stringRGBA(renderer, x, y, "(Fertile) Reproduction Bonus: ++", goodColor.r, goodColor.g, goodColor.b, 255);
+        y += lineHeight;
+        stringRGBA(renderer, x, y, "          Max HP Penalty: -", badColor.r, badColor.g, badColor.b, 255);
+        y += lineHeight;
+    }
+    y += 10;
+
+    stringRGBA(renderer, x, y, "--- Weapon Stats ---", statColor.r, statColor.g, statColor.b, 255); y += lineHeight;
+    stringRGBA(renderer, x, y, ("Damage: " + std::to_string(entity.getDamage())).c_str(), statColor.r, statColor.g, statColor.b, 255); y += lineHeight;
+    stringRGBA(renderer, x, y, ("Range: " + std::to_string(entity.getAttackRange())).c_str(), statColor.r, statColor.g, statColor.b, 255); y += lineHeight;
+    stringRGBA(renderer, x, y, ("Cooldown: " + std::to_string(entity.getAttackCooldown()) + " ms").c_str(), statColor.r, statColor.g, statColor.b, 255); y += lineHeight;
+    stringRGBA(renderer, x, y, ("Stamina Cost: " + std::to_string(entity.getStaminaAttackCost())).c_str(), statColor.r, statColor.g, statColor.b, 255); y += lineHeight;
+
+    if (entity.getProjectileSpeed() > 0) {
+        stringRGBA(renderer, x, y, ("Proj Speed: " + std::to_string(entity.getProjectileSpeed())).c_str(), statColor.r, statColor.g, statColor.b, 255); y += lineHeight;
+        stringRGBA(renderer, x, y, ("Proj Radius: " + std::to_string(entity.getProjectileRadius())).c_str(), statColor.r, statColor.g, statColor.b, 255);
+    }
+}
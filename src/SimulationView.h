@@ -0,0 +1,61 @@
+#ifndef EVOARENA_SIMULATIONVIEW_H
+#define EVOARENA_SIMULATIONVIEW_H
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+#include "constants.h"
+#include "core/Simulation.h"
+
+// SDL front-end of a Simulation: draws the world and handles the inspection panel
+// (entity selection and genealogy navigation). The simulation itself knows nothing about SDL.
+class SimulationView {
+public:
+    SimulationView();
+
+    // Drops the selection and hides the panel (used when a new simulation starts)
+    void reset();
+
+    // Handles user input events
+    void handleEvent(const SDL_Event& event, const Camera& cam, const Simulation& sim);
+
+    // Refreshes the selection and animates the panel (once per frame)
+    void update(const Simulation& sim);
+
+    // Renders the simulation
+    void render(SDL_Renderer* renderer, const Simulation& sim, bool showDebug, const Camera& cam);
+
+private:
+    // Drawing helpers
+    void drawEntity(SDL_Renderer* renderer, const Entity& entity, SimTick currentTick, SimTick lastFeed, const Camera& cam, bool showDebug);
+    void drawProjectile(SDL_Renderer* renderer, const ProjectilePool& projectiles, int i, const Camera& cam);
+    void drawStatsPanel(SDL_Renderer* renderer, int panelX);
+
+    // Entity shown in the panel, with its lineage (kept by the Simulation in a side table)
+    struct Inspected {
+        Entity entity;
+        Lineage lineage;
+    };
+
+    // Pushes the entity on the inspection stack with its lineage
+    void inspect(const Entity& entity, const Simulation& sim);
+
+    // Selection state
+    EntityId selectedId;
+    const Entity* selectedLivingEntity = nullptr;
+    std::vector<Inspected> inspectionStack;
+    int observedEpoch = -1;
+
+    // Last simulation tick shown by the previous frame (keeps flashes visible at high speed)
+    SimTick previousFrameTick = 0;
+    SimTick currentFrameTick = 0;
+
+    // UI panel state
+    float panelTargetX = 0.0f;
+    float panelCurrentX = 0.0f;
+    SDL_Rect panelParent1_rect{};
+    SDL_Rect panelParent2_rect{};
+    SDL_Rect panelBack_rect{};
+};
+
+#endif //EVOARENA_SIMULATIONVIEW_H
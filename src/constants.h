@@ -1,6 +1,8 @@
 #ifndef EVOARENA_CONSTANTS_H
 #define EVOARENA_CONSTANTS_H
 
+#include <cstdint>
+
 // Window dimensions
 extern int WINDOW_WIDTH;
 extern int WINDOW_HEIGHT;
@@ -9,6 +11,14 @@ extern int WINDOW_HEIGHT;
 extern int WORLD_WIDTH;
 extern int WORLD_HEIGHT;
 
+// RGBA color used by the simulation core (kept free of any SDL type)
+struct Color {
+    std::uint8_t r = 0;
+    std::uint8_t g = 0;
+    std::uint8_t b = 0;
+    std::uint8_t a = 255;
+};
+
 // Camera structure
 struct Camera {
     float x = 0.0f;   // Camera X position
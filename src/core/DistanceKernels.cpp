@@ -0,0 +1,178 @@
+#include "DistanceKernels.h"
+#include <cmath>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define EVOARENA_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace {
+    using Kernel = NearestResult (*)(const float*, const float*, const std::uint8_t*, int, float, float, float);
+
+    // Kernel chosen for this CPU and its display name
+    struct KernelChoice {
+        Kernel kernel;
+        const char* name;
+    };
+
+    // Scalar scan of [begin, end), continuing from the best point found so far.
+    // Strictly smaller distances only, so the first of equal points is kept.
+    void scanScalar(const float* xs, const float* ys, const std::uint8_t* mask, int begin, int end,
+                    float qx, float qy, float& bestSq, int& bestIdx) {
+        for (int k = begin; k < end; ++k) {
+            if (mask && !mask[k]) continue;
+            float dx = xs[k] - qx;
+            float dy = ys[k] - qy;
+            float distSq = dx * dx + dy * dy;
+            if (distSq < bestSq) { bestSq = distSq; bestIdx = k; }
+        }
+    }
+
+    // Smallest float strictly greater than maxDistSq: "distSq < limit" accepts the points at
+    // exactly maxDistSq, which lets every kernel use a single strict comparison
+    float acceptLimit(float maxDistSq) {
+        return std::nextafter(maxDistSq, INFINITY);
+    }
+
+    // Picks the best of the per-lane winners (smallest distance, then lowest position)
+    void reduceLanes(const float* laneSq, const int* laneIdx, int lanes, float& bestSq, int& bestIdx) {
+        for (int l = 0; l < lanes; ++l) {
+            if (laneIdx[l] < 0) continue;
+            if (bestIdx < 0 || laneSq[l] < bestSq || (laneSq[l] == bestSq && laneIdx[l] < bestIdx)) {
+                bestSq = laneSq[l];
+                bestIdx = laneIdx[l];
+            }
+        }
+    }
+
+    // Packs the search state into the result (the limit is not a distance)
+    NearestResult makeResult(float bestSq, int bestIdx) {
+        NearestResult result;
+        if (bestIdx >= 0) {
+            result.index = bestIdx;
+            result.distSq = bestSq;
+        }
+        return result;
+    }
+
+    // Portable version, also used for the tails of the vector kernels
+    NearestResult nearestScalar(const float* xs, const float* ys, const std::uint8_t* mask, int count,
+                                float qx, float qy, float maxDistSq) {
+        float bestSq = acceptLimit(maxDistSq);
+        int bestIdx = -1;
+        scanScalar(xs, ys, mask, 0, count, qx, qy, bestSq, bestIdx);
+        return makeResult(bestSq, bestIdx);
+    }
+
+#ifdef EVOARENA_X86_KERNELS
+    // 4 points per step. Each lane keeps its own best (distance, position); a lane only sees
+    // increasing positions, so the strict comparison keeps the first of its ties
+    __attribute__((target("sse2")))
+    NearestResult nearestSse2(const float* xs, const float* ys, const std::uint8_t* mask, int count,
+                              float qx, float qy, float maxDistSq) {
+        float limit = acceptLimit(maxDistSq);
+        const __m128 qxV = _mm_set1_ps(qx);
+        const __m128 qyV = _mm_set1_ps(qy);
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i step = _mm_set1_epi32(4);
+        __m128 bestV = _mm_set1_ps(limit);
+        __m128i bestI = _mm_set1_epi32(-1);
+        __m128i idxV = _mm_setr_epi32(0, 1, 2, 3);
+
+        int k = 0;
+        for (; k + 4 <= count; k += 4) {
+            __m128 dx = _mm_sub_ps(_mm_loadu_ps(xs + k), qxV);
+            __m128 dy = _mm_sub_ps(_mm_loadu_ps(ys + k), qyV);
+            __m128 distSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+            __m128 take = _mm_cmplt_ps(distSq, bestV);
+            if (mask) {
+                int word;
+                std::memcpy(&word, mask + k, sizeof(word));
+                __m128i bytes = _mm_cvtsi32_si128(word);
+                __m128i lanes = _mm_unpacklo_epi16(_mm_unpacklo_epi8(bytes, zero), zero);
+                take = _mm_and_ps(take, _mm_castsi128_ps(_mm_cmpgt_epi32(lanes, zero)));
+            }
+            __m128i takeI = _mm_castps_si128(take);
+            bestV = _mm_or_ps(_mm_and_ps(take, distSq), _mm_andnot_ps(take, bestV));
+            bestI = _mm_or_si128(_mm_and_si128(takeI, idxV), _mm_andnot_si128(takeI, bestI));
+            idxV = _mm_add_epi32(idxV, step);
+        }
+
+        alignas(16) float laneSq[4];
+        alignas(16) int laneIdx[4];
+        _mm_store_ps(laneSq, bestV);
+        _mm_store_si128((__m128i*)laneIdx, bestI);
+        float bestSq = limit;
+        int bestIdx = -1;
+        reduceLanes(laneSq, laneIdx, 4, bestSq, bestIdx);
+        scanScalar(xs, ys, mask, k, count, qx, qy, bestSq, bestIdx);
+        return makeResult(bestSq, bestIdx);
+    }
+
+    // Same as the SSE2 kernel with 8 points per step
+    __attribute__((target("avx2")))
+    NearestResult nearestAvx2(const float* xs, const float* ys, const std::uint8_t* mask, int count,
+                              float qx, float qy, float maxDistSq) {
+        float limit = acceptLimit(maxDistSq);
+        const __m256 qxV = _mm256_set1_ps(qx);
+        const __m256 qyV = _mm256_set1_ps(qy);
+        const __m256i step = _mm256_set1_epi32(8);
+        __m256 bestV = _mm256_set1_ps(limit);
+        __m256i bestI = _mm256_set1_epi32(-1);
+        __m256i idxV = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+        int k = 0;
+        for (; k + 8 <= count; k += 8) {
+            __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(xs + k), qxV);
+            __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(ys + k), qyV);
+            __m256 distSq = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+            __m256 take = _mm256_cmp_ps(distSq, bestV, _CMP_LT_OQ);
+            if (mask) {
+                __m256i lanes = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(mask + k)));
+                take = _mm256_and_ps(take, _mm256_castsi256_ps(_mm256_cmpgt_epi32(lanes, _mm256_setzero_si256())));
+            }
+            bestV = _mm256_blendv_ps(bestV, distSq, take);
+            bestI = _mm256_blendv_epi8(bestI, idxV, _mm256_castps_si256(take));
+            idxV = _mm256_add_epi32(idxV, step);
+        }
+
+        alignas(32) float laneSq[8];
+        alignas(32) int laneIdx[8];
+        _mm256_store_ps(laneSq, bestV);
+        _mm256_store_si256((__m256i*)laneIdx, bestI);
+        float bestSq = limit;
+        int bestIdx = -1;
+        reduceLanes(laneSq, laneIdx, 8, bestSq, bestIdx);
+        scanScalar(xs, ys, mask, k, count, qx, qy, bestSq, bestIdx);
+        return makeResult(bestSq, bestIdx);
+    }
+#endif
+
+    // Picks the widest kernel the CPU supports
+    KernelChoice selectKernel() {
+#ifdef EVOARENA_X86_KERNELS
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return {nearestAvx2, "avx2"};
+        if (__builtin_cpu_supports("sse2")) return {nearestSse2, "sse2"};
+#endif
+        return {nearestScalar, "scalar"};
+    }
+
+    // Resolved once, on first use (thread-safe static initialisation)
+    const KernelChoice& kernelChoice() {
+        static const KernelChoice choice = selectKernel();
+        return choice;
+    }
+}
+
+// Forwards to the kernel selected for this CPU
+NearestResult findNearestMasked(const float* xs, const float* ys, const std::uint8_t* mask, int count,
+                                float qx, float qy, float maxDistSq) {
+    return kernelChoice().kernel(xs, ys, mask, count, qx, qy, maxDistSq);
+}
+
+// Name of the selected kernel
+const char* getDistanceKernelName() {
+    return kernelChoice().name;
+}
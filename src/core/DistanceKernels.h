@@ -0,0 +1,25 @@
+#ifndef EVOARENA_DISTANCEKERNELS_H
+#define EVOARENA_DISTANCEKERNELS_H
+
+#include <cstdint>
+
+// Closest point found by findNearestMasked
+struct NearestResult {
+    int index = -1;         // Position in the input arrays, -1 if no point qualified
+    float distSq = 0.0f;    // Squared distance to the query point
+};
+
+// Batch nearest-point search: squared distances from (qx, qy) to the count points of the
+// contiguous xs/ys arrays, skipping points whose mask byte is 0 (mask may be null: all points
+// qualify) and points farther than maxDistSq. Ties go to the lowest position.
+//
+// Runs an AVX2 or SSE2 kernel when the CPU has one (chosen once at runtime, so the same binary
+// runs everywhere) and a scalar loop otherwise. All versions do the same float operations in the
+// same order per point, so they return the same result on every host.
+NearestResult findNearestMasked(const float* xs, const float* ys, const std::uint8_t* mask, int count,
+                                float qx, float qy, float maxDistSq);
+
+// Name of the kernel selected for this CPU ("avx2", "sse2" or "scalar")
+const char* getDistanceKernelName();
+
+#endif //EVOARENA_DISTANCEKERNELS_H
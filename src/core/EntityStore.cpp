@@ -0,0 +1,51 @@
+#include "EntityStore.h"
+
+// Copies the hot fields of every entity into the parallel arrays (no reallocation once warm)
+void EntityStore::capture(const std::vector<Entity>& entities) {
+    resize((int)entities.size());
+    for (int i = 0; i < (int)entities.size(); ++i) write(i, entities[i]);
+}
+
+// Resizes every array to the same length
+void EntityStore::resize(int count) {
+    posX.resize(count);
+    posY.resize(count);
+    rad.resize(count);
+    alive.resize(count);
+    type.resize(count);
+    health.resize(count);
+    maxHealth.resize(count);
+    clan.resize(count);
+}
+
+// Copies one entity's hot fields into its slot
+void EntityStore::write(int i, const Entity& entity) {
+    posX[i] = (float)entity.getX();
+    posY[i] = (float)entity.getY();
+    rad[i] = entity.getRad();
+    alive[i] = entity.getIsAlive() ? 1 : 0;
+    type[i] = (std::uint8_t)entity.getEntityType();
+    health[i] = entity.getHealth();
+    maxHealth[i] = entity.getMaxHealth();
+    clan[i] = entity.getClanId();
+}
+
+// Stable compaction keeping the slots whose entity is still alive
+void EntityStore::removeDead(const std::vector<Entity>& entities) {
+    int kept = 0;
+    for (int i = 0; i < (int)entities.size(); ++i) {
+        if (!entities[i].getIsAlive()) continue;
+        if (kept != i) {
+            posX[kept] = posX[i];
+            posY[kept] = posY[i];
+            rad[kept] = rad[i];
+            alive[kept] = alive[i];
+            type[kept] = type[i];
+            health[kept] = health[i];
+            maxHealth[kept] = maxHealth[i];
+            clan[kept] = clan[i];
+        }
+        kept++;
+    }
+    resize(kept);
+}
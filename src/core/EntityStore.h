@@ -0,0 +1,56 @@
+#ifndef EVOARENA_ENTITYSTORE_H
+#define EVOARENA_ENTITYSTORE_H
+
+#include <vector>
+#include <cstdint>
+#include "../constants.h"
+#include "../Entity/Entity.h"
+
+// Structure-of-arrays copy of the fields read by perception, indexed like the entity vector.
+// Neighbour scans walk a few small parallel arrays instead of pulling whole Entity objects
+// (names, genome, stats) through the cache. The Entity objects stay the owners of the state.
+//
+// Simulation double-buffers it: during a tick every worker reads the front store (state at the
+// end of the previous tick) and writes only its own entities' slots of the back store, so no
+// slot is ever read and written concurrently. The two are swapped when the tick ends.
+class EntityStore {
+public:
+    // Copies the hot fields of every entity (dead ones included, so indices match)
+    void capture(const std::vector<Entity>& entities);
+
+    // Resizes the arrays, keeping the existing slots
+    void resize(int count);
+
+    // Overwrites slot i with the entity's current hot fields
+    void write(int i, const Entity& entity);
+
+    // Drops the slots of dead entities, mirroring the compaction of the entity vector
+    void removeDead(const std::vector<Entity>& entities);
+
+    int size() const { return (int)posX.size(); }
+
+    // Hot fields of entity i
+    float getX(int i) const { return posX[i]; }
+    float getY(int i) const { return posY[i]; }
+    int getRad(int i) const { return rad[i]; }
+    bool getIsAlive(int i) const { return alive[i] != 0; }
+    int getEntityType(int i) const { return type[i]; }
+    int getHealth(int i) const { return health[i]; }
+    int getMaxHealth(int i) const { return maxHealth[i]; }
+    int getClanId(int i) const { return clan[i]; }
+
+    // Same rule as Entity::isAlliedWith, on the stored clans
+    bool areAllied(int a, int b) const { return clan[a] == clan[b]; }
+
+private:
+    std::vector<float> posX;
+    std::vector<float> posY;
+    std::vector<int> rad;
+    std::vector<std::uint8_t> alive;
+    std::vector<std::uint8_t> type;
+    std::vector<int> health;
+    std::vector<int> maxHealth;
+    std::vector<int> clan;
+};
+
+#endif //EVOARENA_ENTITYSTORE_H
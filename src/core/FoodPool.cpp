@@ -0,0 +1,82 @@
+#include "FoodPool.h"
+#include "DistanceKernels.h"
+
+// Constructor: Allocates one empty bucket per cell of the world
+FoodPool::FoodPool(int cellSize) : cellSize(std::max(1, cellSize)) {
+    cols = std::max(1, (WORLD_WIDTH + this->cellSize - 1) / this->cellSize);
+    rows = std::max(1, (WORLD_HEIGHT + this->cellSize - 1) / this->cellSize);
+    cells.resize(cols * rows);
+    cellX.resize(cols * rows);
+    cellY.resize(cols * rows);
+}
+
+// Appends the item and files it in the bucket of its cell
+void FoodPool::add(const Food& food) {
+    int cell = cellCoord((float)food.y, rows) * cols + cellCoord((float)food.x, cols);
+    itemCell.push_back(cell);
+    itemSlot.push_back((int)cells[cell].size());
+    cells[cell].push_back((int)items.size());
+    cellX[cell].push_back((float)food.x);
+    cellY[cell].push_back((float)food.y);
+    items.push_back(food);
+}
+
+// Swap-removes the item from its bucket, then from the dense array
+void FoodPool::remove(int i) {
+    int cell = itemCell[i];
+    std::vector<int>& bucket = cells[cell];
+    int movedInBucket = bucket.back();
+    bucket[itemSlot[i]] = movedInBucket;
+    cellX[cell][itemSlot[i]] = cellX[cell].back();
+    cellY[cell][itemSlot[i]] = cellY[cell].back();
+    itemSlot[movedInBucket] = itemSlot[i];
+    bucket.pop_back();
+    cellX[cell].pop_back();
+    cellY[cell].pop_back();
+
+    int last = (int)items.size() - 1;
+    if (i != last) {
+        items[i] = items[last];
+        itemCell[i] = itemCell[last];
+        itemSlot[i] = itemSlot[last];
+        cells[itemCell[i]][itemSlot[i]] = i;
+    }
+    items.pop_back();
+    itemCell.pop_back();
+    itemSlot.pop_back();
+}
+
+// Empties the dense array and every bucket (keeping their capacity)
+void FoodPool::clear() {
+    items.clear();
+    itemCell.clear();
+    itemSlot.clear();
+    for (auto& bucket : cells) bucket.clear();
+    for (auto& coords : cellX) coords.clear();
+    for (auto& coords : cellY) coords.clear();
+}
+
+// Runs the distance kernel over each bucket overlapping the search circle
+int FoodPool::findNearest(float x, float y, float maxDistance) const {
+    int minCX = cellCoord(x - maxDistance, cols);
+    int maxCX = cellCoord(x + maxDistance, cols);
+    int minCY = cellCoord(y - maxDistance, rows);
+    int maxCY = cellCoord(y + maxDistance, rows);
+    int best = -1;
+    float bestSq = maxDistance * maxDistance;
+
+    for (int cy = minCY; cy <= maxCY; ++cy) {
+        for (int cx = minCX; cx <= maxCX; ++cx) {
+            int cell = cy * cols + cx;
+            if (cells[cell].empty()) continue;
+            NearestResult nearest = findNearestMasked(cellX[cell].data(), cellY[cell].data(), nullptr,
+                                                      (int)cells[cell].size(), x, y, bestSq);
+            if (nearest.index == -1) continue;
+            if (best == -1 || nearest.distSq < bestSq) {
+                best = cells[cell][nearest.index];
+                bestSq = nearest.distSq;
+            }
+        }
+    }
+    return best;
+}
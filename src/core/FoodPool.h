@@ -0,0 +1,75 @@
+#ifndef EVOARENA_FOODPOOL_H
+#define EVOARENA_FOODPOOL_H
+
+#include <vector>
+#include <algorithm>
+#include "../constants.h"
+
+// Food lying in the world, kept dense for drawing and bucketed by grid cell for queries.
+// Each item remembers its cell and its slot in that cell's bucket, so removing one is two
+// swap-removes (dense array and bucket) and never shifts the other items.
+// Only mutated by the serial phases; perception reads it concurrently.
+class FoodPool {
+public:
+    // Food item lying in the world
+    struct Food {
+        int x, y;
+        int radius = 4;
+    };
+
+    explicit FoodPool(int cellSize = 128);
+
+    // Adds a food item
+    void add(const Food& food);
+
+    // Removes item i in O(1); the last item takes its index
+    void remove(int i);
+
+    void clear();
+    int size() const { return (int)items.size(); }
+    const Food& get(int i) const { return items[i]; }
+    const std::vector<Food>& getItems() const { return items; }
+
+    // Returns the index of the closest item within maxDistance of (x, y), or -1 if none.
+    // Only the cells overlapping that circle are visited, each with the batch distance kernel
+    // over its coordinate arrays. Ties go to the first item in bucket order, cells row by row.
+    int findNearest(float x, float y, float maxDistance) const;
+
+    // Calls fn(index) for every item whose cell overlaps the circle (x, y, radius).
+    // Candidates are not distance-filtered and may be removed by fn (the bucket is walked
+    // backwards, so the swap-remove only moves items already visited).
+    template <typename Fn>
+    void forEachInRadius(float x, float y, float radius, Fn&& fn) {
+        int minCX = cellCoord(x - radius, cols);
+        int maxCX = cellCoord(x + radius, cols);
+        int minCY = cellCoord(y - radius, rows);
+        int maxCY = cellCoord(y + radius, rows);
+
+        for (int cy = minCY; cy <= maxCY; ++cy) {
+            for (int cx = minCX; cx <= maxCX; ++cx) {
+                const std::vector<int>& bucket = cells[cy * cols + cx];
+                for (int k = (int)bucket.size() - 1; k >= 0; --k) {
+                    if (k < (int)bucket.size()) fn(bucket[k]);
+                }
+            }
+        }
+    }
+
+private:
+    // Converts a world coordinate to a clamped cell coordinate
+    int cellCoord(float v, int count) const {
+        return std::clamp((int)(v / (float)cellSize), 0, count - 1);
+    }
+
+    int cellSize;
+    int cols;
+    int rows;
+    std::vector<Food> items;
+    std::vector<int> itemCell;             // Cell of each item
+    std::vector<int> itemSlot;             // Position of each item in its cell's bucket
+    std::vector<std::vector<int>> cells;   // Item indices per cell (cols * rows buckets)
+    std::vector<std::vector<float>> cellX; // Coordinates of the bucketed items, parallel to cells
+    std::vector<std::vector<float>> cellY;
+};
+
+#endif //EVOARENA_FOODPOOL_H
@@ -0,0 +1,49 @@
+#include "NeighborLists.h"
+
+// Constructor: Stores the skin margin, lists start invalid
+NeighborLists::NeighborLists(float skin) : skin(skin) {}
+
+// Stale if invalidated, resized, or if any living entity moved more than half the skin
+bool NeighborLists::isStale(const EntityStore& store) const {
+    if (!valid || store.size() != (int)lists.size()) return true;
+    float limitSq = 0.25f * skin * skin;
+    for (int i = 0; i < store.size(); ++i) {
+        if (!store.getIsAlive(i)) continue;
+        float dx = store.getX(i) - buildX[i];
+        float dy = store.getY(i) - buildY[i];
+        if (dx * dx + dy * dy > limitSq) return true;
+    }
+    return false;
+}
+
+// Records the positions the displacement check will compare against
+void NeighborLists::prepare(const EntityStore& store) {
+    int count = store.size();
+    buildX.resize(count);
+    buildY.resize(count);
+    lists.resize(count);
+    for (int i = 0; i < count; ++i) {
+        buildX[i] = store.getX(i);
+        buildY[i] = store.getY(i);
+    }
+    valid = true;
+    rebuildCount++;
+}
+
+// Grid query with the enlarged radius, keeping the candidates inside the circle
+void NeighborLists::build(int i, const EntityStore& store, const SpatialGrid& grid, float radius) {
+    std::vector<int>& list = lists[i];
+    list.clear();
+    if (!store.getIsAlive(i)) return;
+
+    float reach = radius + skin;
+    float reachSq = reach * reach;
+    float selfX = store.getX(i);
+    float selfY = store.getY(i);
+    grid.forEachInRadius(selfX, selfY, reach, [&](int otherIdx) {
+        if (otherIdx == i) return;
+        float dx = selfX - store.getX(otherIdx);
+        float dy = selfY - store.getY(otherIdx);
+        if (dx * dx + dy * dy <= reachSq) list.push_back(otherIdx);
+    });
+}
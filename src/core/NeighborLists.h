@@ -0,0 +1,50 @@
+#ifndef EVOARENA_NEIGHBORLISTS_H
+#define EVOARENA_NEIGHBORLISTS_H
+
+#include <vector>
+#include "EntityStore.h"
+#include "SpatialGrid.h"
+
+// Verlet neighbour lists: for every entity, the indices of the entities that were within its
+// perception radius plus a skin margin when the lists were built. As long as no entity has
+// moved more than half the skin since then, every entity now inside the perception radius is
+// still in the list, so perception scans the short list instead of querying the grid.
+//
+// The lists hold entity indices, so they also go stale whenever the population changes
+// (deaths compact the entity vector, a new generation replaces it): Simulation invalidates them.
+class NeighborLists {
+public:
+    explicit NeighborLists(float skin);
+
+    // True if the lists must be rebuilt before being read against this store
+    bool isStale(const EntityStore& store) const;
+
+    // Forces the next isStale() to report true
+    void invalidate() { valid = false; }
+
+    // Starts a rebuild: records the reference positions and sizes the lists (serial).
+    // Every list must then be filled with build() before the lists are read.
+    void prepare(const EntityStore& store);
+
+    // Fills the list of entity i with the living entities within radius + skin of it.
+    // Safe to call concurrently for different entities.
+    void build(int i, const EntityStore& store, const SpatialGrid& grid, float radius);
+
+    // Candidates of entity i, in grid order (not distance-filtered)
+    const std::vector<int>& get(int i) const { return lists[i]; }
+
+    float getSkin() const { return skin; }
+
+    // Number of rebuilds since construction
+    long long getRebuildCount() const { return rebuildCount; }
+
+private:
+    float skin;
+    bool valid = false;
+    long long rebuildCount = 0;
+    std::vector<float> buildX;          // Position of each entity when the lists were built
+    std::vector<float> buildY;
+    std::vector<std::vector<int>> lists; // Kept across rebuilds so a warm rebuild never allocates
+};
+
+#endif //EVOARENA_NEIGHBORLISTS_H
@@ -0,0 +1,108 @@
+#include "ProjectilePool.h"
+#include <cmath>
+
+namespace {
+    // Integration kernel. The arrays never overlap; __restrict on the parameters tells the
+    // compiler so, and the body is branch-free, which lets the loop vectorise.
+    void integrateSlots(float* __restrict px, float* __restrict py, float* __restrict ox, float* __restrict oy,
+                        const float* __restrict dx, const float* __restrict dy, const float* __restrict sp,
+                        float* __restrict tr, const float* __restrict rg, std::uint8_t* __restrict live,
+                        int begin, int end) {
+        const float maxX = (float)WORLD_WIDTH;
+        const float maxY = (float)WORLD_HEIGHT;
+        for (int i = begin; i < end; ++i) {
+            ox[i] = px[i];
+            oy[i] = py[i];
+            px[i] += dx[i] * sp[i];
+            py[i] += dy[i] * sp[i];
+            tr[i] += sp[i];
+            bool spent = (tr[i] >= rg[i]) | (px[i] < 0.0f) | (px[i] > maxX) | (py[i] < 0.0f) | (py[i] > maxY);
+            live[i] = live[i] & (std::uint8_t)!spent;
+        }
+    }
+}
+
+// Constructor: Allocates the slots up front
+ProjectilePool::ProjectilePool(int capacity) {
+    reserve(capacity);
+}
+
+// Resizes every slot array to the new capacity (never shrinks)
+void ProjectilePool::reserve(int newCapacity) {
+    if (newCapacity <= capacity) return;
+    capacity = newCapacity;
+    posX.resize(capacity);
+    posY.resize(capacity);
+    prevX.resize(capacity);
+    prevY.resize(capacity);
+    dirX.resize(capacity);
+    dirY.resize(capacity);
+    speed.resize(capacity);
+    traveled.resize(capacity);
+    range.resize(capacity);
+    alive.resize(capacity);
+    damage.resize(capacity);
+    radius.resize(capacity);
+    color.resize(capacity);
+    shooter.resize(capacity);
+}
+
+// Fills the next free slot, computing the normalized direction towards the target
+bool ProjectilePool::spawn(const Spawn& spawn) {
+    float distX = spawn.targetX - spawn.startX;
+    float distY = spawn.targetY - spawn.startY;
+    float distance = std::sqrt(distX * distX + distY * distY);
+    if (distance <= 0.0f) return false;
+
+    if (count == capacity) reserve(capacity > 0 ? capacity * 2 : 64);
+
+    int i = count++;
+    posX[i] = spawn.startX;
+    posY[i] = spawn.startY;
+    prevX[i] = spawn.startX;
+    prevY[i] = spawn.startY;
+    dirX[i] = distX / distance;
+    dirY[i] = distY / distance;
+    speed[i] = (float)spawn.speed;
+    traveled[i] = 0.0f;
+    range[i] = (float)spawn.range;
+    alive[i] = 1;
+    damage[i] = spawn.damage;
+    radius[i] = spawn.radius;
+    color[i] = spawn.color;
+    shooter[i] = spawn.shooter;
+    return true;
+}
+
+// One step of every projectile in the range
+void ProjectilePool::integrate(int begin, int end) {
+    integrateSlots(posX.data(), posY.data(), prevX.data(), prevY.data(), dirX.data(), dirY.data(),
+                   speed.data(), traveled.data(), range.data(), alive.data(), begin, end);
+}
+
+// Fills every dead slot with the last live projectile, walking from the end
+void ProjectilePool::removeDead() {
+    for (int i = count - 1; i >= 0; --i) {
+        if (alive[i]) continue;
+        int last = --count;
+        if (i != last) moveSlot(last, i);
+    }
+}
+
+// Copies every array entry of one slot into another
+void ProjectilePool::moveSlot(int from, int to) {
+    posX[to] = posX[from];
+    posY[to] = posY[from];
+    prevX[to] = prevX[from];
+    prevY[to] = prevY[from];
+    dirX[to] = dirX[from];
+    dirY[to] = dirY[from];
+    speed[to] = speed[from];
+    traveled[to] = traveled[from];
+    range[to] = range[from];
+    alive[to] = alive[from];
+    damage[to] = damage[from];
+    radius[to] = radius[from];
+    color[to] = color[from];
+    shooter[to] = shooter[from];
+}
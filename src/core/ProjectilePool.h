@@ -0,0 +1,83 @@
+#ifndef EVOARENA_PROJECTILEPOOL_H
+#define EVOARENA_PROJECTILEPOOL_H
+
+#include <vector>
+#include <cstdint>
+#include "../constants.h"
+#include "../Entity/EntityId.h"
+
+// Every projectile in flight, stored as parallel arrays (structure of arrays). Slots are
+// allocated once up to the capacity, so firing never allocates, and dead projectiles are
+// removed by moving the last one into their slot (order is not preserved, but it stays
+// deterministic since every pool operation runs on one thread or on disjoint slots).
+class ProjectilePool {
+public:
+    // Parameters of a new projectile, aimed from its start point at a target point
+    struct Spawn {
+        float startX, startY;
+        float targetX, targetY;
+        int speed;
+        int damage;
+        int range;
+        int radius;
+        Color color;
+        EntityId shooter;
+    };
+
+    explicit ProjectilePool(int capacity = 0);
+
+    // Grows the slot arrays to hold at least capacity projectiles
+    void reserve(int capacity);
+
+    // Adds a projectile; returns false (and adds nothing) if it has no direction to fly in.
+    // Only grows the arrays if the capacity is exhausted.
+    bool spawn(const Spawn& spawn);
+
+    // Moves the projectiles of slots [begin, end) one tick and flags the ones that ran out of
+    // range or left the world. Written as a flat loop over the arrays so it vectorises.
+    void integrate(int begin, int end);
+
+    // Flags a projectile as spent (e.g. after a hit)
+    void kill(int i) { alive[i] = 0; }
+
+    // Swap-removes every flagged projectile
+    void removeDead();
+
+    void clear() { count = 0; }
+    int size() const { return count; }
+
+    // Slot accessors
+    float getX(int i) const { return posX[i]; }
+    float getY(int i) const { return posY[i]; }
+    float getPrevX(int i) const { return prevX[i]; }   // Position before the last integration
+    float getPrevY(int i) const { return prevY[i]; }
+    int getRadius(int i) const { return radius[i]; }
+    int getDamage(int i) const { return damage[i]; }
+    Color getColor(int i) const { return color[i]; }
+    EntityId getShooterId(int i) const { return shooter[i]; }
+    bool isAlive(int i) const { return alive[i] != 0; }
+
+private:
+    // Copies slot 'from' into slot 'to'
+    void moveSlot(int from, int to);
+
+    int count = 0;
+    int capacity = 0;
+
+    // Motion (hot, touched by the integration loop)
+    std::vector<float> posX, posY;
+    std::vector<float> prevX, prevY;
+    std::vector<float> dirX, dirY;
+    std::vector<float> speed;
+    std::vector<float> traveled;
+    std::vector<float> range;
+    std::vector<std::uint8_t> alive;
+
+    // Hit and display data
+    std::vector<int> damage;
+    std::vector<int> radius;
+    std::vector<Color> color;
+    std::vector<EntityId> shooter;
+};
+
+#endif //EVOARENA_PROJECTILEPOOL_H
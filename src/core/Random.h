@@ -0,0 +1,50 @@
+#ifndef EVOARENA_RANDOM_H
+#define EVOARENA_RANDOM_H
+
+#include <cstdint>
+
+// Counter-based random stream. Every value is a pure function of (key, counter), so a
+// stream costs two integers to create and the same key always replays the same values.
+// Simulation keys one stream per (seed, entity, tick): results do not depend on which
+// worker thread updates an entity, nor on how many workers there are.
+class RandomStream {
+public:
+    // Stream identified by a seed and up to two extra key words (e.g. entity key and tick)
+    explicit RandomStream(std::uint64_t seed, std::uint64_t keyA = 0, std::uint64_t keyB = 0)
+            : key(mix(mix(mix(seed) ^ keyA) ^ keyB)) {}
+
+    // Next raw 64-bit value
+    std::uint64_t nextU64() {
+        return mix(key + (++counter) * GOLDEN_GAMMA);
+    }
+
+    // Uniform integer in [0, bound) (bound > 0)
+    int nextInt(int bound) {
+        return (int)(((nextU64() >> 32) * (std::uint64_t)bound) >> 32);
+    }
+
+    // Uniform float in [0, 1)
+    float nextFloat() {
+        return (float)(nextU64() >> 40) * (1.0f / 16777216.0f);
+    }
+
+    // Uniform float in [min, max)
+    float nextRange(float min, float max) {
+        return min + (max - min) * nextFloat();
+    }
+
+    // SplitMix64 finalizer: a bijective avalanche of a 64-bit word
+    static std::uint64_t mix(std::uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+private:
+    static constexpr std::uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ULL;
+
+    std::uint64_t key;
+    std::uint64_t counter = 0;
+};
+
+#endif //EVOARENA_RANDOM_H
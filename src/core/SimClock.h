@@ -0,0 +1,19 @@
+#ifndef EVOARENA_SIMCLOCK_H
+#define EVOARENA_SIMCLOCK_H
+
+#include <algorithm>
+#include <cstdint>
+
+// Index of a simulation tick. Every timer of the simulation is expressed in ticks so that
+// results do not depend on how fast the host runs the simulation.
+using SimTick = std::int64_t;
+
+// Fixed duration of one tick (the GUI runs one tick per frame at 1x, about 60 frames per second)
+constexpr std::uint32_t SIM_TICK_MS = 16;
+
+// Converts a duration in milliseconds to whole ticks (rounded up, at least one tick)
+constexpr SimTick msToTicks(std::uint32_t ms) {
+    return std::max<SimTick>(1, (SimTick)((ms + SIM_TICK_MS - 1) / SIM_TICK_MS));
+}
+
+#endif //EVOARENA_SIMCLOCK_H
@@ -1,19 +1,17 @@
 #include "Simulation.h"
 #include "../constants.h"
 #include "../Entity/TraitManager.h"
+#include "Sweep.h"
+#include "DistanceKernels.h"
 #include <cmath>
 #include <algorithm>
+#include <array>
+#include <chrono>
 #include <ctime>
-#include <iomanip>
-#include <sstream>
 #include <string>
-#include <thread>
-#include <mutex>
-#include "../menu.h"
 
 namespace {
-    // Constants for UI and genetic parameters
-    const int PANEL_WIDTH = 300;
+    // Constants for genetic parameters
     const int SURVIVOR_COUNT = 20;
     const int MUTATION_CHANCE_PERCENT = 5;
     const int RAD_MUTATION_AMOUNT = 3;
@@ -27,14 +25,70 @@ namespace {
     const float AIM_MAX = 15.0f;
     const int FERTILITY_MAX_INT = 2;
     const float AGING_MAX_FLOAT = 0.01f;
+
+    // Perception parameters
+    const float FLEE_DANGER_DISTANCE = 150.0f;
+
+    // A hostile this close makes a healer defend itself instead of healing
+    const float HEALER_SELF_DEFENSE_DISTANCE = 20.0f;
+
+    // Maximum L1 distance (summed RGB differences) between a color and its clan leader's color
+    const int CLAN_COLOR_DISTANCE = 30;
+
+    // Margin added to the perception radius in the neighbour lists. Entities move 5 to 18 units
+    // per tick, so the lists survive a few ticks before anyone crosses half of it
+    const float NEIGHBOR_SKIN = 80.0f;
+
+    // Radius beyond which no other entity can change an entity's decision
+    float perceptionRadiusOf(const Entity& entity) {
+        return std::max((float)entity.getSightRadius(), FLEE_DANGER_DISTANCE);
+    }
+
+    // Entities per work-stealing chunk in the parallel update
+    const int UPDATE_GRAIN_SIZE = 16;
+
+    // Distance a melee hit pushes its target back
+    const int MELEE_KNOCKBACK_FORCE = 40;
+
+    // Projectiles per work-stealing chunk in the projectile phase
+    const int PROJECTILE_GRAIN_SIZE = 32;
+
+    // Initial projectile pool slots per entity (the pool only grows past this in extreme fights)
+    const int PROJECTILES_PER_ENTITY = 4;
+
+    // Grid cells per work-stealing chunk in the collision phase
+    const int COLLISION_GRAIN_SIZE = 8;
+
+    // Share of an overlap an entity moves away per pass (the other entity moves the rest)
+    const float SEPARATION_FACTOR = 0.5f;
+
+    // Key of the serial random stream, kept apart from the per-entity keys (packed EntityIds)
+    const std::uint64_t SERIAL_STREAM_KEY = 0x53455249414CULL;
+
+    // Base key of the per-child reproduction streams (plus the population epoch)
+    const std::uint64_t REPRODUCTION_STREAM_KEY = 0x4252454544ULL << 24;
+
+    // Children per work-stealing chunk in the reproduction phase
+    const int REPRODUCTION_GRAIN_SIZE = 32;
 }
 
 // Constructor: Initializes the simulation with the maximum number of entities
-Simulation::Simulation(int maxEntities) :
+Simulation::Simulation(int maxEntities, unsigned int threadCount, unsigned int seed) :
         maxEntities(maxEntities),
-        selectedLivingEntity(nullptr) {
-    panelCurrentX = (float)WINDOW_WIDTH;
-    panelTargetX = (float)WINDOW_WIDTH;
+        seed(seed != 0 ? seed : (std::uint64_t)std::time(nullptr)),
+        neighborLists(NEIGHBOR_SKIN),
+        rng(this->seed, SERIAL_STREAM_KEY),
+        workerPool(threadCount) {
+    // One spawn buffer per worker, large enough for every entity firing in the same tick
+    projectileSpawns.resize(workerPool.getThreadCount());
+    for (auto& buffer : projectileSpawns) buffer.reserve(maxEntities);
+    spawnMergeScratch.reserve(maxEntities);
+    projectiles.reserve(PROJECTILES_PER_ENTITY * maxEntities);
+    interactionBuffers.resize(workerPool.getThreadCount());
+    for (auto& buffer : interactionBuffers) buffer.reserve(2 * maxEntities);
+    interactionScratch.reserve(2 * maxEntities);
+    perceptionScratch.resize(workerPool.getThreadCount());
+    for (auto& scratch : perceptionScratch) scratch.resize(maxEntities);
     TraitManager::loadTraits("../assets/json/mutations.JSON");
     initialize(maxEntities);
 }
@@ -47,54 +101,55 @@ void Simulation::initialize(int initialEntityCount) {
     currentGeneration = 0;
     entities.clear();
     projectiles.clear();
-    lastShotTime.clear();
     genealogyArchive.clear();
-    inspectionStack.clear();
-    selectedLivingEntity = nullptr;
+    archivedLineages.clear();
+    lineages.clear();
+    reproductionMs = 0.0;
     foods.clear();
-
-    panelCurrentX = (float)WINDOW_WIDTH;
-    panelTargetX = (float)WINDOW_WIDTH;
-
-    std::srand(std::time(0));
+    populationEpoch++;
 
     for (int i = 0; i < initialEntityCount; ++i) {
-        float newGeneticCode[14];
+        Genome newGeneticCode;
 
         // Generate random genetic code for the entity
-        newGeneticCode[0] = 10.0f + (float)(std::rand() % 31); // Size
+        newGeneticCode[0] = 10.0f + (float)rng.nextInt(31); // Size
         int randomRad = (int)newGeneticCode[0];
-        int randomX = randomRad + (std::rand() % (WORLD_WIDTH - 2 * randomRad));
-        int randomY = randomRad + (std::rand() % (WORLD_HEIGHT - 2 * randomRad));
-        std::string name = "G0-E" + std::to_string(i + 1);
-        SDL_Color color = Entity::generateRandomColor();
+        int randomX = randomRad + rng.nextInt(WORLD_WIDTH - 2 * randomRad);
+        int randomY = randomRad + rng.nextInt(WORLD_HEIGHT - 2 * randomRad);
+        Color color = Entity::generateRandomColor(rng);
 
         // Weapon and role assignment
-        newGeneticCode[1] = (float)(std::rand() % 101); // Weapon type
-        newGeneticCode[2] = (10 + (std::rand() % 91)) / 100.0f; // Kite distance
-        int roleRoll = std::rand() % 100;
+        newGeneticCode[1] = (float)rng.nextInt(101); // Weapon type
+        newGeneticCode[2] = (10 + rng.nextInt(91)) / 100.0f; // Kite distance
+        int roleRoll = rng.nextInt(100);
         newGeneticCode[10] = (roleRoll < 33) ? 0.15f : (roleRoll < 66) ? 0.50f : 0.85f;
-        newGeneticCode[10] += ((float)(std::rand() % 11) - 5.0f) / 100.0f;
+        newGeneticCode[10] += ((float)rng.nextInt(11) - 5.0f) / 100.0f;
 
         // Reset biological genes
         for (int j = 3; j <= 9; ++j) newGeneticCode[j] = 0.0f;
 
         // Assign a dominant trait
         int maxTraits = TraitManager::getCount();
-        newGeneticCode[11] = (maxTraits > 1 && (std::rand() % 100) < 20) ? 
-                             (float)(1 + (std::rand() % (maxTraits - 1))) : 0.0f;
+        newGeneticCode[11] = (maxTraits > 1 && rng.nextInt(100) < 20) ? 
+                             (float)(1 + rng.nextInt(maxTraits - 1)) : 0.0f;
 
         // Behavioral genes
-        newGeneticCode[12] = (float)(std::rand() % 101) / 100.0f; // Bravery
-        newGeneticCode[13] = (float)(std::rand() % 101) / 100.0f; // Greed
+        newGeneticCode[12] = (float)rng.nextInt(101) / 100.0f; // Bravery
+        newGeneticCode[13] = (float)rng.nextInt(101) / 100.0f; // Greed
 
-        entities.emplace_back(name, randomX, randomY, color, newGeneticCode, currentGeneration, "NONE", "NONE");
+        EntityId id{(std::uint32_t)(i + 1), (std::uint32_t)populationEpoch};
+        entities.emplace_back(id, randomX, randomY, color, newGeneticCode, rng);
+        lineages.push_back({currentGeneration, EntityId{}, EntityId{}});
     }
+    lastFeedTicks.assign(entities.size(), NEVER_FED);
+    assignClans();
 }
 
-// Handles reproduction and creates a new generation
+// Produces the next population from the survivors. Children do not depend on one another:
+// each draws from its own stream keyed by (seed, population, child index), so the workers
+// build them in parallel batches straight into their final slots and the result does not
+// depend on the thread count
 void Simulation::triggerReproduction(const std::vector<Entity>& parents) {
-    std::vector<Entity> newGeneration;
     int numParents = parents.size();
 
     if (parents.empty() || numParents < 2) {
@@ -102,99 +157,156 @@ void Simulation::triggerReproduction(const std::vector<Entity>& parents) {
         return;
     }
 
-    int newGen = parents[0].getGeneration() + 1;
-    this->currentGeneration = newGen;
-
-    // Create a lottery for parent selection
-    std::vector<int> parentLottery;
-    parentLottery.reserve(numParents * 10);
+    auto start = std::chrono::steady_clock::now();
+    this->currentGeneration++;
+    populationEpoch++;
 
+    // Lottery for parent selection: parent i owns the draws in [ticketEnds[i - 1], ticketEnds[i])
+    ticketEnds.resize(numParents);
+    int totalTickets = 0;
     for (int i = 0; i < numParents; ++i) {
         int tickets = 1;
         tickets += parents[i].getFertilityFactor() * 3;
         if (parents[i].getCurrentTraitID() == 7) tickets += 15; // Trait Fertile
-
-        for (int t = 0; t < tickets; ++t) parentLottery.push_back(i);
+        totalTickets += tickets;
+        ticketEnds[i] = totalTickets;
     }
 
     // Generate children
-    for (int i = 0; i < maxEntities; ++i) {
-        int p1_index = parentLottery[std::rand() % parentLottery.size()];
-        int p2_index = parentLottery[std::rand() % parentLottery.size()];
-
-        const Entity& parent1 = parents[p1_index];
-        const Entity* parent2_ptr = &parents[p2_index];
-
-        int attempts = 0;
-        while (parent1.getName() == parent2_ptr->getName() && attempts < 15) {
-            p2_index = parentLottery[std::rand() % parentLottery.size()];
-            parent2_ptr = &parents[p2_index];
-            attempts++;
+    nextGeneration.resize(maxEntities);
+    nextLineages.resize(maxEntities);
+    workerPool.parallelFor(maxEntities, REPRODUCTION_GRAIN_SIZE, [this, &parents](int, int begin, int end) {
+        for (int i = begin; i < end; ++i) this->breedChild(parents, i);
+    });
+
+    entities.swap(nextGeneration);
+    lineages.swap(nextLineages);
+    lastFeedTicks.assign(entities.size(), NEVER_FED);
+    assignClans();
+    reproductionMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Draws a parent index from the lottery (binary search in the cumulative tickets)
+int Simulation::drawParent(RandomStream& childRng) const {
+    int draw = childRng.nextInt(ticketEnds.back());
+    return (int)(std::upper_bound(ticketEnds.begin(), ticketEnds.end(), draw) - ticketEnds.begin());
+}
+
+// Builds child childIndex of the new population into its slot (used by threads)
+void Simulation::breedChild(const std::vector<Entity>& parents, int childIndex) {
+    RandomStream childRng(seed, REPRODUCTION_STREAM_KEY + (std::uint64_t)populationEpoch, (std::uint64_t)childIndex);
+
+    const Entity& parent1 = parents[drawParent(childRng)];
+    const Entity* parent2_ptr = &parents[drawParent(childRng)];
+
+    int attempts = 0;
+    while (parent1.getId() == parent2_ptr->getId() && attempts < 15) {
+        parent2_ptr = &parents[drawParent(childRng)];
+        attempts++;
+    }
+    const Entity& parent2 = *parent2_ptr;
+
+    Genome childGeneticCode;
+
+    for (int idx = 0; idx < Genome::GENE_COUNT; ++idx) {
+        float geneP1 = parent1.getGenome()[idx];
+        float geneP2 = parent2.getGenome()[idx];
+        int crossoverStrategy = childRng.nextInt(3);
+
+        if (crossoverStrategy == 0) {
+            childGeneticCode[idx] = (geneP1 + geneP2) / 2.0f;
+        } else if (crossoverStrategy == 1) {
+            childGeneticCode[idx] = (childRng.nextInt(2) == 0) ? geneP1 : geneP2;
+        } else  {
+            float ratio = (float)childRng.nextInt(101) / 100.0f;
+            childGeneticCode[idx] = geneP1 * ratio + geneP2 * (1.0f - ratio);
         }
-        const Entity& parent2 = *parent2_ptr;
-
-        float childGeneticCode[14];
-
-        for (int idx = 0; idx < 14; ++idx) {
-            float geneP1 = parent1.getGeneticCode()[idx];
-            float geneP2 = parent2.getGeneticCode()[idx];
-            int crossoverStrategy = std::rand() % 3;
-
-            if (crossoverStrategy == 0) {
-                childGeneticCode[idx] = (geneP1 + geneP2) / 2.0f;
-            } else if (crossoverStrategy == 1) {
-                childGeneticCode[idx] = (std::rand() % 2 == 0) ? geneP1 : geneP2;
-            } else  {
-                float ratio = (float)(std::rand() % 101) / 100.0f;
-                childGeneticCode[idx] = geneP1 * ratio + geneP2 * (1.0f - ratio);
-            }
 
-            if ((std::rand() % 100) < MUTATION_CHANCE_PERCENT) {
-                if (idx == 10) { // Role
-                    childGeneticCode[idx] += ((float)((std::rand() % 41) - 20) / 100.0f);
-                } else if (idx == 0) { // Size
-                    childGeneticCode[idx] += (float)((std::rand() % 7) - 3);
-                } else {
-                    childGeneticCode[idx] += ((float)((std::rand() % 21) - 10) / 100.0f);
-                }
+        if (childRng.nextInt(100) < MUTATION_CHANCE_PERCENT) {
+            if (idx == 10) { // Role
+                childGeneticCode[idx] += ((float)(childRng.nextInt(41) - 20) / 100.0f);
+            } else if (idx == 0) { // Size
+                childGeneticCode[idx] += (float)(childRng.nextInt(7) - 3);
+            } else {
+                childGeneticCode[idx] += ((float)(childRng.nextInt(21) - 10) / 100.0f);
             }
-
-            // Clamp values
-            if (idx == 0) childGeneticCode[idx] = std::max(10.0f, std::min(50.0f, childGeneticCode[idx]));
-            else if (idx == 10) childGeneticCode[idx] = std::clamp(childGeneticCode[idx], 0.0f, 1.0f);
-            else if (idx != 11 && childGeneticCode[idx] < 0) childGeneticCode[idx] = 0.0f;
         }
 
-        // Trait inheritance
-        int chosenID = 0;
-        int roll = std::rand() % 100;
-        if (roll < 45) chosenID = parent1.getCurrentTraitID();
-        else if (roll < 90) chosenID = parent2.getCurrentTraitID();
-        else {
-            int maxTraits = TraitManager::getCount();
-            if (maxTraits > 1) chosenID = 1 + (std::rand() % (maxTraits - 1));
+        // Clamp values
+        if (idx == 0) childGeneticCode[idx] = std::max(10.0f, std::min(50.0f, childGeneticCode[idx]));
+        else if (idx == 10) childGeneticCode[idx] = std::clamp(childGeneticCode[idx], 0.0f, 1.0f);
+        else if (idx != 11 && childGeneticCode[idx] < 0) childGeneticCode[idx] = 0.0f;
+    }
+
+    // Trait inheritance
+    int chosenID = 0;
+    int roll = childRng.nextInt(100);
+    if (roll < 45) chosenID = parent1.getCurrentTraitID();
+    else if (roll < 90) chosenID = parent2.getCurrentTraitID();
+    else {
+        int maxTraits = TraitManager::getCount();
+        if (maxTraits > 1) chosenID = 1 + childRng.nextInt(maxTraits - 1);
+    }
+    childGeneticCode[11] = (float)chosenID;
+
+    // Color inheritance
+    Color c1 = parent1.getColor();
+    Color c2 = parent2.getColor();
+    Color childColor;
+    childColor.r = (std::uint8_t)std::clamp(((int)c1.r + (int)c2.r) / 2 + (childRng.nextInt(21) - 10), 0, 255);
+    childColor.g = (std::uint8_t)std::clamp(((int)c1.g + (int)c2.g) / 2 + (childRng.nextInt(21) - 10), 0, 255);
+    childColor.b = (std::uint8_t)std::clamp(((int)c1.b + (int)c2.b) / 2 + (childRng.nextInt(21) - 10), 0, 255);
+    childColor.a = 255;
+
+    EntityId childId{(std::uint32_t)(childIndex + 1), (std::uint32_t)populationEpoch};
+    int randomRad = (int)childGeneticCode[0];
+    int randomX = randomRad + childRng.nextInt(WORLD_WIDTH - 2 * randomRad);
+    int randomY = randomRad + childRng.nextInt(WORLD_HEIGHT - 2 * randomRad);
+    nextGeneration[childIndex] = Entity(childId, randomX, randomY, childColor, childGeneticCode, childRng);
+    nextLineages[childIndex] = {currentGeneration, parent1.getId(), parent2.getId()};
+}
+
+// Groups the population into clans by color, once per generation (colors never change while
+// an entity lives). Greedy leader clustering: in index order, each entity joins the first clan
+// whose leader's color is within CLAN_COLOR_DISTANCE of its own, or leads a new one.
+// Unlike the pairwise color rule it replaces, the result is an equivalence relation.
+void Simulation::assignClans() {
+    std::vector<Color> leaders;
+    for (auto& entity : entities) {
+        Color c = entity.getColor();
+        int clan = -1;
+        for (int k = 0; k < (int)leaders.size() && clan == -1; ++k) {
+            int diff = std::abs(c.r - leaders[k].r) + std::abs(c.g - leaders[k].g) + std::abs(c.b - leaders[k].b);
+            if (diff < CLAN_COLOR_DISTANCE) clan = k;
+        }
+        if (clan == -1) {
+            clan = (int)leaders.size();
+            leaders.push_back(c);
         }
-        childGeneticCode[11] = (float)chosenID;
-
-        // Color inheritance
-        SDL_Color c1 = parent1.getColor();
-        SDL_Color c2 = parent2.getColor();
-        SDL_Color childColor;
-        childColor.r = (Uint8)std::clamp(((int)c1.r + (int)c2.r) / 2 + (std::rand()%21 - 10), 0, 255);
-        childColor.g = (Uint8)std::clamp(((int)c1.g + (int)c2.g) / 2 + (std::rand()%21 - 10), 0, 255);
-        childColor.b = (Uint8)std::clamp(((int)c1.b + (int)c2.b) / 2 + (std::rand()%21 - 10), 0, 255);
-        childColor.a = 255;
-
-        std::string newName = "G" + std::to_string(newGen) + "-E" + std::to_string(i + 1);
-        int randomRad = (int)childGeneticCode[0];
-        int randomX = randomRad + (std::rand() % (WORLD_WIDTH - 2 * randomRad));
-        int randomY = randomRad + (std::rand() % (WORLD_HEIGHT - 2 * randomRad));
-        newGeneration.emplace_back(newName, randomX, randomY, childColor, childGeneticCode, newGen, parent1.getName(), parent2.getName());
+        entity.setClanId(clan);
     }
+    clanCount = (int)leaders.size();
+}
 
-    entities = std::move(newGeneration);
-    selectedLivingEntity = nullptr;
-    inspectionStack.clear();
+// Lists the wounded non-healers of every clan from the snapshot (counting sort by clan,
+// ascending index inside a clan)
+void Simulation::rebuildWoundedAllies() {
+    const EntityStore& store = entityStores[frontStore];
+    clanWoundedStart.assign(clanCount + 1, 0);
+    auto isWounded = [&store](int i) {
+        return store.getIsAlive(i) && store.getHealth(i) < store.getMaxHealth(i) && store.getEntityType(i) != Entity::HEALER;
+    };
+
+    for (int i = 0; i < store.size(); ++i) {
+        if (isWounded(i)) clanWoundedStart[store.getClanId(i) + 1]++;
+    }
+    for (int c = 0; c < clanCount; ++c) clanWoundedStart[c + 1] += clanWoundedStart[c];
+
+    clanWoundedItems.resize(clanWoundedStart[clanCount]);
+    clanWoundedCursor.assign(clanWoundedStart.begin(), clanWoundedStart.end() - 1);
+    for (int i = 0; i < store.size(); ++i) {
+        if (isWounded(i)) clanWoundedItems[clanWoundedCursor[store.getClanId(i)]++] = i;
+    }
 }
 
 // Restarts the simulation manually
@@ -202,158 +314,209 @@ void Simulation::triggerManualRestart() {
     triggerReproduction(lastSurvivors);
 }
 
-// Handles user input events
-void Simulation::handleEvent(const SDL_Event &event, const Camera& cam) {
-    if (event.type == SDL_MOUSEBUTTONDOWN && event.button.button == SDL_BUTTON_LEFT) {
-        int mouseX = event.button.x;
-        int mouseY = event.button.y;
-        SDL_Point mousePoint = {mouseX, mouseY};
-
-        // Handle clicks on the UI panel
-        if (!inspectionStack.empty() && mouseX > panelCurrentX) {
-            if (SDL_PointInRect(&mousePoint, &panelBack_rect) && inspectionStack.size() > 1) inspectionStack.pop_back();
-            else if (SDL_PointInRect(&mousePoint, &panelParent1_rect)) {
-                std::string p1_name = inspectionStack.back().getParent1Name();
-                if (genealogyArchive.count(p1_name)) inspectionStack.push_back(genealogyArchive.at(p1_name));
-            } else if (SDL_PointInRect(&mousePoint, &panelParent2_rect)) {
-                std::string p2_name = inspectionStack.back().getParent2Name();
-                if (genealogyArchive.count(p2_name)) inspectionStack.push_back(genealogyArchive.at(p2_name));
-            }
-            return;
-        }
+// Returns an archived survivor by id, or nullptr if it was never archived
+const Entity* Simulation::findArchivedEntity(EntityId id) const {
+    auto it = genealogyArchive.find(id);
+    return (it != genealogyArchive.end()) ? &it->second : nullptr;
+}
 
-        // Handle clicks in the world (entity selection)
-        float worldMouseX = mouseX / cam.zoom + cam.x;
-        float worldMouseY = mouseY / cam.zoom + cam.y;
-        bool entityClicked = false;
-        for (auto& entity : entities) {
-            if (!entity.getIsAlive()) continue;
-            int dx = worldMouseX - entity.getX();
-            int dy = worldMouseY - entity.getY();
-            if (std::sqrt((float)dx*dx + dy*dy) < entity.getRad()) {
-                selectedLivingEntity = &entity;
-                inspectionStack.clear();
-                inspectionStack.push_back(entity);
-                entityClicked = true;
-                break;
-            }
-        }
-        if (!entityClicked) { selectedLivingEntity = nullptr; inspectionStack.clear(); }
+// Looks the lineage up in the current population's table, then in the archive
+const Lineage* Simulation::findLineage(EntityId id) const {
+    if (id.tag == (std::uint32_t)populationEpoch && id.index >= 1 && id.index <= lineages.size()) {
+        return &lineages[id.index - 1];
     }
+    auto it = archivedLineages.find(id);
+    return (it != archivedLineages.end()) ? &it->second : nullptr;
 }
 
-// Updates the simulation state, including multithreaded logic and physics
-Simulation::SimUpdateStatus Simulation::update(int speedMultiplier, bool autoRestart) {
-    unsigned int numThreads = std::thread::hardware_concurrency();
-    if (numThreads == 0) numThreads = 2;
-
-    std::vector<std::thread> threads;
-    int totalEntities = entities.size();
-    int chunkSize = totalEntities / numThreads;
-
-    // Launch threads for logic and physics updates
-    for (unsigned int i = 0; i < numThreads; ++i) {
-        int start = i * chunkSize;
-        int end = (i == numThreads - 1) ? totalEntities : (start + chunkSize);
+// Tick of the entity's last meal (NEVER_FED outside the current population)
+SimTick Simulation::getLastFeedTick(EntityId id) const {
+    if (id.tag != (std::uint32_t)populationEpoch || id.index < 1 || id.index > lastFeedTicks.size()) return NEVER_FED;
+    return lastFeedTicks[id.index - 1];
+}
 
-        threads.emplace_back([this, start, end, speedMultiplier]() {
-            this->updateLogicAndPhysicsRange(start, end, speedMultiplier);
-        });
+// Updates the simulation state, including multithreaded logic and physics
+Simulation::SimUpdateStatus Simulation::update(bool autoRestart) {
+    workerPool.resetStats();
+
+    // A new population has no previous tick: take its snapshot directly
+    if (snapshotEpoch != populationEpoch) {
+        entityStores[frontStore].capture(entities);
+        snapshotEpoch = populationEpoch;
+        neighborLists.invalidate();
     }
 
-    // Wait for threads to finish
-    for (auto& t : threads) {
-        if (t.joinable()) t.join();
-    }
+    // Index the snapshot positions so searches only visit nearby cells
+    entityGrid.rebuild(entityStores[frontStore]);
+    rebuildNeighborListsIfStale();
+    rebuildWoundedAllies();
+    entityStores[1 - frontStore].resize((int)entities.size());
+
+    // Logic and physics updates on the persistent workers, one specialised kernel per role
+    partitionByRole();
+    runRoleUpdate<Entity::MELEE>();
+    runRoleUpdate<Entity::RANGED>();
+    runRoleUpdate<Entity::HEALER>();
+    mergeProjectileSpawns();
+    applyInteractions();
+    resolveCollisions();
 
     // Sequential updates
     spawnFood();
-    updateFood(speedMultiplier);
+    updateFood();
     updateProjectiles();
     cleanupDead();
+    frontStore = 1 - frontStore;
+    currentTick++;
 
     // Handle end of generation
     if (entities.size() <= SURVIVOR_COUNT && !entities.empty()) {
         lastSurvivors = entities;
-        for (const auto& winner : lastSurvivors) genealogyArchive.insert({winner.getName(), winner});
+        for (const auto& winner : lastSurvivors) {
+            genealogyArchive.insert({winner.getId(), winner});
+            archivedLineages.insert({winner.getId(), lineages[winner.getId().index - 1]});
+        }
         if (autoRestart) { triggerReproduction(lastSurvivors); return SimUpdateStatus::RUNNING; }
         else return SimUpdateStatus::FINISHED;
     }
 
-    // UI animation
-    if (!inspectionStack.empty()) panelTargetX = (float)(WINDOW_WIDTH - PANEL_WIDTH); else panelTargetX = (float)WINDOW_WIDTH;
-    if(selectedLivingEntity != nullptr && !selectedLivingEntity->getIsAlive()) selectedLivingEntity = nullptr;
-    float distance = panelTargetX - panelCurrentX;
-    if (std::abs(distance) < 1.0f) panelCurrentX = panelTargetX; else panelCurrentX += distance * 0.1f;
-
     return SimUpdateStatus::RUNNING;
 }
 
-// Updates a range of entities' logic and physics (used by threads)
-void Simulation::updateLogicAndPhysicsRange(int startIdx, int endIdx, int speedMultiplier) {
-    for (int i = startIdx; i < endIdx; ++i) {
+// Rebuilds every neighbour list on the workers when the population changed or an entity
+// moved more than half the skin since the last build
+void Simulation::rebuildNeighborListsIfStale() {
+    const EntityStore& store = entityStores[frontStore];
+    neighborListsRebuilt = neighborLists.isStale(store);
+    if (!neighborListsRebuilt) return;
+
+    neighborLists.prepare(store);
+    workerPool.parallelFor(store.size(), UPDATE_GRAIN_SIZE, [this, &store](int, int start, int end) {
+        for (int i = start; i < end; ++i) {
+            neighborLists.build(i, store, entityGrid, perceptionRadiusOf(entities[i]));
+        }
+    });
+}
+
+// Groups the entity indices by role (counting sort, ascending index inside a role).
+// Dead entities only get their slot of the next snapshot written
+void Simulation::partitionByRole() {
+    roleStart.fill(0);
+    EntityStore& next = entityStores[1 - frontStore];
+    for (int i = 0; i < (int)entities.size(); ++i) {
+        if (entities[i].getIsAlive()) roleStart[entities[i].getEntityType() + 1]++;
+        else next.write(i, entities[i]);
+    }
+    for (int r = 0; r < Entity::ROLE_COUNT; ++r) roleStart[r + 1] += roleStart[r];
+
+    roleItems.resize(roleStart[Entity::ROLE_COUNT]);
+    std::array<int, Entity::ROLE_COUNT> cursor;
+    std::copy(roleStart.begin(), roleStart.end() - 1, cursor.begin());
+    for (int i = 0; i < (int)entities.size(); ++i) {
+        if (entities[i].getIsAlive()) roleItems[cursor[entities[i].getEntityType()]++] = i;
+    }
+}
+
+// Runs the update kernel of one role on the workers and times it
+template <int Role>
+void Simulation::runRoleUpdate() {
+    auto start = std::chrono::steady_clock::now();
+    int count = roleStart[Role + 1] - roleStart[Role];
+    workerPool.parallelFor(count, UPDATE_GRAIN_SIZE, [this](int worker, int begin, int end) {
+        this->updateRoleRange<Role>(worker, roleStart[Role] + begin, roleStart[Role] + end);
+    });
+    roleStats[Role].entities = count;
+    roleStats[Role].updateMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Updates the logic and physics of the living entities roleItems[begin, end), all of the given
+// role (used by threads). The role is a template parameter so that every role test below is
+// resolved at compile time and each kernel only contains its own branches
+template <int Role>
+void Simulation::updateRoleRange(int worker, int begin, int end) {
+    constexpr bool isHealer = (Role == Entity::HEALER);
+    constexpr bool isRanged = (Role == Entity::RANGED);
+    EntityStore& next = entityStores[1 - frontStore];
+
+    for (int slot = begin; slot < end; ++slot) {
+        int i = roleItems[slot];
         Entity& entity = entities[i];
-        if (!entity.getIsAlive()) continue;
+
+        // Draws depend only on (seed, entity, tick), never on the worker running this chunk
+        RandomStream rng(seed, entity.getRngKey(), (std::uint64_t)currentTick);
 
         // Perception and decision-making
-        Entity* closestTarget = nullptr;
+        // Targets beyond both the sight radius and the flee threshold never change the decision,
+        // so only the entity's neighbour list (that radius plus the skin) is scanned
+        // Other entities are read from the store (start-of-tick state), never from live objects
+        const EntityStore& store = entityStores[frontStore];
+        int closestIdx = -1;
         float closestDist = 100000.0f;
         bool targetIsFriendly = false;
-
-        for (auto &other : entities) {
-            if (&entity != &other && other.getIsAlive()) {
-                float dist = std::hypot(entity.getX() - other.getX(), entity.getY() - other.getY());
-
-                bool isHealer = (entity.getEntityType() == 2);
-                bool isAlly = entity.isAlliedWith(other);
-                bool isValidTarget = false;
-                bool isFriendlyInteraction = false;
-
-                if (isHealer) {
-                    if (isAlly && other.getHealth() < other.getMaxHealth() && other.getEntityType() != 2) {
-                        isValidTarget = true;
-                        isFriendlyInteraction = true;
-                    } else if (!isAlly) {
-                        isValidTarget = true;
-                        isFriendlyInteraction = false;
-                    }
-                } else {
-                    isValidTarget = true;
-                    isFriendlyInteraction = false;
-                }
-
-                if (isValidTarget) {
-                    if (targetIsFriendly && !isFriendlyInteraction) {
-                        if (dist < 20.0f) {
-                            closestDist = dist; closestTarget = &other; targetIsFriendly = false;
-                        }
-                    } else if (dist < closestDist) {
-                        closestDist = dist; closestTarget = &other; targetIsFriendly = isFriendlyInteraction;
-                    }
-                }
+        float perceptionRadius = perceptionRadiusOf(entity);
+        float perceptionRadiusSq = perceptionRadius * perceptionRadius;
+        float selfX = store.getX(i);
+        float selfY = store.getY(i);
+
+        // Nearest entity of the neighbour list (healers only look at other clans there).
+        // Candidates are gathered into contiguous arrays for the batch distance kernel
+        PerceptionScratch& scratch = perceptionScratch[worker];
+        const std::vector<int>& neighbors = neighborLists.get(i);
+        scratch.resize((int)neighbors.size());
+        for (int k = 0; k < (int)neighbors.size(); ++k) {
+            int otherIdx = neighbors[k];
+            scratch.x[k] = store.getX(otherIdx);
+            scratch.y[k] = store.getY(otherIdx);
+            if constexpr (isHealer) scratch.mask[k] = store.getIsAlive(otherIdx) && !store.areAllied(i, otherIdx);
+            else scratch.mask[k] = store.getIsAlive(otherIdx);
+        }
+        NearestResult nearest = findNearestMasked(scratch.x.data(), scratch.y.data(), scratch.mask.data(),
+                                                  (int)neighbors.size(), selfX, selfY, perceptionRadiusSq);
+        float closestSq = nearest.distSq;
+        if (nearest.index != -1) closestIdx = neighbors[nearest.index];
+
+        // Healers also look up the wounded allies of their clan directly. The nearest hostile
+        // still wins if it is very close or closer than the nearest wounded ally
+        if constexpr (isHealer) {
+            int clan = store.getClanId(i);
+            int first = clanWoundedStart[clan];
+            int woundedCount = clanWoundedStart[clan + 1] - first;
+            scratch.resize(woundedCount);
+            for (int k = 0; k < woundedCount; ++k) {
+                int otherIdx = clanWoundedItems[first + k];
+                scratch.x[k] = store.getX(otherIdx);
+                scratch.y[k] = store.getY(otherIdx);
+                scratch.mask[k] = (otherIdx != i);
+            }
+            NearestResult ally = findNearestMasked(scratch.x.data(), scratch.y.data(), scratch.mask.data(),
+                                                   woundedCount, selfX, selfY, perceptionRadiusSq);
+
+            bool hostileFirst = (closestIdx != -1) &&
+                                (ally.index == -1 || closestSq < HEALER_SELF_DEFENSE_DISTANCE * HEALER_SELF_DEFENSE_DISTANCE || closestSq < ally.distSq);
+            if (!hostileFirst && ally.index != -1) {
+                closestIdx = clanWoundedItems[first + ally.index];
+                closestSq = ally.distSq;
+                targetIsFriendly = true;
             }
         }
+        if (closestIdx != -1) closestDist = std::sqrt(closestSq);
 
         // Food perception
-        int foodIndex = -1;
-        float closestFoodDist = 100000.0f;
-        for (size_t k = 0; k < foods.size(); ++k) {
-            float d = std::hypot(entity.getX() - foods[k].x, entity.getY() - foods[k].y);
-            if (d < closestFoodDist) { closestFoodDist = d; foodIndex = (int)k; }
-        }
+        // Only food within sight is considered
+        int foodIndex = foods.findNearest(selfX, selfY, (float)entity.getSightRadius());
 
         // Decision-making
         float healthPct = (float)entity.getHealth() / (float)entity.getMaxHealth();
         float staminaPct = (float)entity.getStamina() / (float)entity.getMaxStamina();
-        bool dangerClose = (closestTarget && closestDist < 150.0f);
+        bool dangerClose = (closestIdx != -1 && closestDist < FLEE_DANGER_DISTANCE);
 
-        if (dangerClose && healthPct < entity.getBravery() && !entity.isAlliedWith(*closestTarget)) {
+        if (dangerClose && healthPct < entity.getBravery() && !store.areAllied(i, closestIdx)) {
             bool stuck = (entity.getX() < 50 || entity.getX() > WORLD_WIDTH - 50 ||
                           entity.getY() < 50 || entity.getY() > WORLD_HEIGHT - 50);
             entity.setCurrentState(stuck ? Entity::COMBAT : Entity::FLEE);
         } else if (staminaPct < entity.getGreed() && foodIndex != -1) {
             entity.setCurrentState(Entity::FORAGE);
-        } else if (closestTarget && closestDist < entity.getSightRadius()) {
+        } else if (closestIdx != -1 && closestDist < entity.getSightRadius()) {
             entity.setCurrentState(Entity::COMBAT);
         } else {
             entity.setCurrentState(Entity::WANDER);
@@ -365,91 +528,76 @@ void Simulation::updateLogicAndPhysicsRange(int startIdx, int endIdx, int speedM
 
         switch (entity.getCurrentState()) {
             case Entity::FLEE: {
-                if (closestTarget) {
-                    int fleeTarget[2] = { entity.getX() + (entity.getX() - closestTarget->getX()),
-                                          entity.getY() + (entity.getY() - closestTarget->getY()) };
-                    entity.chooseDirection(fleeTarget);
+                if (closestIdx != -1) {
+                    int fleeTarget[2] = { entity.getX() + (entity.getX() - (int)store.getX(closestIdx)),
+                                          entity.getY() + (entity.getY() - (int)store.getY(closestIdx)) };
+                    entity.chooseDirection(rng, fleeTarget);
                     entity.setIsFleeing(true);
                 }
                 break;
             }
             case Entity::FORAGE: {
                 if (foodIndex != -1) {
-                    int target[2] = {foods[foodIndex].x, foods[foodIndex].y};
-                    entity.chooseDirection(target);
+                    int target[2] = {foods.get(foodIndex).x, foods.get(foodIndex).y};
+                    entity.chooseDirection(rng, target);
                 }
                 break;
             }
             case Entity::COMBAT: {
-                if (!closestTarget) break;
-                int targetPos[2] = {closestTarget->getX(), closestTarget->getY()};
+                if (closestIdx == -1) break;
+                int targetPos[2] = {(int)store.getX(closestIdx), (int)store.getY(closestIdx)};
                 int attackRange = entity.getAttackRange();
-                bool isRanged = (entity.getEntityType() == 1);
-                bool isHealer = (entity.getEntityType() == 2);
 
                 // Combat movement
-                if (isHealer) {
+                if constexpr (isHealer) {
                     if (targetIsFriendly) {
-                        if (closestDist < entity.getRad() + closestTarget->getRad() + 10) entity.chooseDirection(nullptr);
-                        else entity.chooseDirection(targetPos);
+                        if (closestDist < entity.getRad() + store.getRad(closestIdx) + 10) entity.chooseDirection(rng, nullptr);
+                        else entity.chooseDirection(rng, targetPos);
                     } else {
-                        if (closestDist > attackRange) entity.chooseDirection(targetPos);
-                        else entity.chooseDirection(nullptr);
+                        if (closestDist > attackRange) entity.chooseDirection(rng, targetPos);
+                        else entity.chooseDirection(rng, nullptr);
                     }
-                } else if (isRanged) {
+                } else if constexpr (isRanged) {
                     float kiteDist = attackRange * entity.getKiteRatio();
                     if (closestDist < kiteDist && entity.getStamina() > 10) {
                         int back[2] = {entity.getX() + (entity.getX() - targetPos[0]), entity.getY() + (entity.getY() - targetPos[1])};
-                        entity.chooseDirection(back);
+                        entity.chooseDirection(rng, back);
                     } else if (closestDist > attackRange) {
-                        entity.chooseDirection(targetPos);
+                        entity.chooseDirection(rng, targetPos);
                     } else {
-                        entity.chooseDirection(nullptr);
+                        entity.chooseDirection(rng, nullptr);
                     }
                 } else {
                     entity.setIsCharging(closestDist > attackRange);
-                    if (closestDist <= attackRange) entity.chooseDirection(nullptr);
-                    else entity.chooseDirection(targetPos);
+                    if (closestDist <= attackRange) entity.chooseDirection(rng, nullptr);
+                    else entity.chooseDirection(rng, targetPos);
                 }
 
                 // Attack or heal
+                // The cooldown lives in the entity: only this worker touches it, no lock needed
                 if (closestDist <= attackRange + 10) {
-                    Uint32 currentTime = SDL_GetTicks();
-                    Uint32 effectiveCooldown = (speedMultiplier > 0) ? (entity.getAttackCooldown() / speedMultiplier) : entity.getAttackCooldown();
-
-                    bool canShoot = false;
-                    {
-                        std::lock_guard<std::mutex> lock(simMutex);
-                        if (lastShotTime.find(entity.getName()) == lastShotTime.end() || currentTime > lastShotTime[entity.getName()] + effectiveCooldown) {
-                            canShoot = true;
-                        }
-                    }
-
-                    if (canShoot) {
-                        if (entity.consumeStamina(entity.getStaminaAttackCost())) {
-                            std::lock_guard<std::mutex> lock(simMutex);
-
-                            lastShotTime[entity.getName()] = currentTime;
+                    if (entity.isAttackReady(currentTick)) {
+                        if (entity.consumeStamina(entity.getStaminaAttackCost(), currentTick)) {
+                            entity.markAttack(currentTick);
 
+                            // Effects on the target are recorded and applied after the join
+                            std::vector<Interaction>& interactions = interactionBuffers[worker];
                             if (isHealer && targetIsFriendly) {
                                 int healAmount = entity.getDamage();
                                 if (entity.getHealth() > healAmount) {
-                                    closestTarget->receiveHealing(healAmount);
+                                    interactions.push_back({closestIdx, i, Interaction::HEAL, healAmount, 0, 0});
                                     entity.takeDamage(healAmount);
                                 }
-                            } else if (isHealer && !targetIsFriendly) {
-                                Projectile newP(entity.getX(), entity.getY(), closestTarget->getX(), closestTarget->getY(),
-                                                entity.getProjectileSpeed(), entity.getDamage(), entity.getAttackRange(),
-                                                entity.getColor(), entity.getProjectileRadius(), entity.getName());
-                                projectiles.push_back(newP);
-                            } else if (isRanged) {
-                                Projectile newP(entity.getX(), entity.getY(), closestTarget->getX(), closestTarget->getY(),
-                                                entity.getProjectileSpeed(), entity.getDamage(), attackRange,
-                                                entity.getColor(), entity.getProjectileRadius(), entity.getName());
-                                projectiles.push_back(newP);
+                            } else if (isHealer || isRanged) {
+                                // Shots go to this worker's own buffer, merged after the join
+                                int range = isHealer ? entity.getAttackRange() : attackRange;
+                                ProjectilePool::Spawn shot{(float)entity.getX(), (float)entity.getY(), (float)targetPos[0], (float)targetPos[1],
+                                                           entity.getProjectileSpeed(), entity.getDamage(), range,
+                                                           entity.getProjectileRadius(), entity.getColor(), entity.getId()};
+                                projectileSpawns[worker].push_back({i, shot});
                             } else {
-                                closestTarget->takeDamage(entity.getDamage());
-                                closestTarget->knockBackFrom(entity.getX(), entity.getY(), 40);
+                                interactions.push_back({closestIdx, i, Interaction::DAMAGE, entity.getDamage(), 0, 0});
+                                interactions.push_back({closestIdx, i, Interaction::KNOCKBACK, MELEE_KNOCKBACK_FORCE, entity.getX(), entity.getY()});
                             }
                         }
                     }
@@ -458,249 +606,281 @@ void Simulation::updateLogicAndPhysicsRange(int startIdx, int endIdx, int speedM
             }
             case Entity::WANDER:
             default: {
-                Entity* globalTarget = nullptr;
-                float minGlobalDist = 1000000.0f;
-                for (auto &other : entities) {
-                    if (&entity != &other && other.getIsAlive()) {
-                        bool isEnemy = !entity.isAlliedWith(other);
-                        bool isEndGameTreason = (entity.getEntityType() == 2 && entities.size() < 5);
-                        if (isEnemy || isEndGameTreason) {
-                            float d = std::hypot(entity.getX() - other.getX(), entity.getY() - other.getY());
-                            if (d < minGlobalDist) { minGlobalDist = d; globalTarget = &other; }
-                        }
-                    }
-                }
-                if (globalTarget) {
-                    int targetPos[2] = {globalTarget->getX(), globalTarget->getY()};
-                    entity.chooseDirection(targetPos);
+                // Nearest enemy anywhere in the world (healers turn on allies at the very end)
+                bool isEndGameTreason = (isHealer && entities.size() < 5);
+                int globalIdx = entityGrid.findNearest(store, selfX, selfY, [&](int otherIdx) {
+                    if (otherIdx == i || !store.getIsAlive(otherIdx)) return false;
+                    return isEndGameTreason || !store.areAllied(i, otherIdx);
+                });
+                if (globalIdx != -1) {
+                    int targetPos[2] = {(int)store.getX(globalIdx), (int)store.getY(globalIdx)};
+                    entity.chooseDirection(rng, targetPos);
                 } else {
                     int center[2] = {WORLD_WIDTH / 2, WORLD_HEIGHT / 2};
-                    entity.chooseDirection(center);
+                    entity.chooseDirection(rng, center);
                 }
                 break;
             }
         }
 
         // Update physics
-        entity.update(speedMultiplier);
-
-        // Handle collisions
-        for (auto &other : entities) {
-            if (&entity != &other && other.getIsAlive()) {
-                int dx = entity.getX() - other.getX();
-                int dy = entity.getY() - other.getY();
-                float distance = std::sqrt((float)dx * dx + (float)dy * dy);
-                int minDistance = entity.getRad() + other.getRad();
-
-                if (distance < minDistance) {
-                    float overlap = minDistance - distance;
-                    float separationFactor = 0.5f;
-                    float separationDistance = overlap * separationFactor;
-                    float normX = (distance > 0) ? dx / distance : 1.0f;
-                    float normY = (distance > 0) ? dy / distance : 0.0f;
-
-                    {
-                        std::lock_guard<std::mutex> lock(simMutex);
-                        entity.setX(entity.getX() + static_cast<int>(normX * separationDistance));
-                        entity.setY(entity.getY() + static_cast<int>(normY * separationDistance));
-                    }
-                }
-            }
-        }
+        entity.update(currentTick, rng);
+
+        // Publish this entity's new state for the next tick (its own slot only)
+        next.write(i, entity);
     }
 }
 
-// Draws the stats panel for the selected entity
-void Simulation::drawStatsPanel(SDL_Renderer* renderer, int panelX) {
-    auto float_to_string = [](float val, int precision = 1) {
-        std::stringstream ss;
-        ss << std::fixed << std::setprecision(precision) << val;
-        return ss.str();
-    };
-
-    if (inspectionStack.empty()) return;
-
-    const Entity* entityToDisplay = (inspectionStack.size() == 1 && selectedLivingEntity) ? selectedLivingEntity : &inspectionStack.back();
-    if (!entityToDisplay) return;
-    const Entity& entity = *entityToDisplay;
-
-    SDL_Rect panelRect = {panelX, 0, PANEL_WIDTH, WINDOW_HEIGHT};
-    SDL_SetRenderDrawColor(renderer, 20, 20, 20, 240);
-    SDL_RenderFillRect(renderer, &panelRect);
-
-    int x = panelX + 15;
-    int y = 20;
-    const int lineHeight = 18;
-
-    SDL_Color titleColor  = {255, 215, 0, 255};
-    SDL_Color statColor   = {220, 220, 220, 255};
-    SDL_Color geneColor   = {100, 200, 255, 255};
-    SDL_Color linkColor   = {80, 80, 255, 255};
-    SDL_Color badColor    = {255, 100, 100, 255};
-    SDL_Color goodColor   = {100, 255, 100, 255};
-    SDL_Color stateColor  = {255, 165, 0, 255};
-
-    if (inspectionStack.size() > 1) {
-        stringRGBA(renderer, x + 10, y + 8, "< Back", statColor.r, statColor.g, statColor.b, 255);
-        panelBack_rect = {x, y, 80, 25};
-        rectangleRGBA(renderer, panelBack_rect.x, panelBack_rect.y, panelBack_rect.x+panelBack_rect.w, panelBack_rect.y+panelBack_rect.h, 255,255,255,100);
-        y += 40;
-    } else {
-        panelBack_rect = {0,0,0,0};
+// Separates overlapping entities after movement. Positions are relaxed as floats over the grid:
+// cells are split in four colors by (column, row) parity and the cells of one color are solved
+// in parallel. A cell only moves its own entities and reads its 8 neighbours, and two cells of
+// the same color are never neighbours, so no lock is needed and the result does not depend on
+// the scheduling.
+void Simulation::resolveCollisions() {
+    if (collisionIterations <= 0) return;
+    EntityStore& next = entityStores[1 - frontStore];
+    entityGrid.rebuild(next);
+
+    int count = next.size();
+    solveX.resize(count);
+    solveY.resize(count);
+    for (int i = 0; i < count; ++i) {
+        solveX[i] = next.getX(i);
+        solveY[i] = next.getY(i);
     }
 
-    stringRGBA(renderer, x, y, ("ID: " + entity.getName()).c_str(), titleColor.r, titleColor.g, titleColor.b, 255); y += lineHeight*1.5;
-
-    std::string hpStr = entityToDisplay == selectedLivingEntity ? std::to_string(entity.getHealth()) : "(Decede)";
-    stringRGBA(renderer, x, y, ("Health: " + hpStr + " / " + std::to_string(entity.getMaxHealth())).c_str(), statColor.r, statColor.g, statColor.b, 255); y += lineHeight;
-    stringRGBA(renderer, x, y, ("Stamina: " + std::to_string(entity.getStamina())).c_str(), statColor.r, statColor.g, statColor.b, 255); y += lineHeight*1.5;
-    stringRGBA(renderer, x, y, ("CURRENT STATE: " + entity.getCurrentStateString()).c_str(), stateColor.r, stateColor.g, stateColor.b, 255);
-    y += lineHeight * 1.5;
-
-    stringRGBA(renderer, x, y, "--- Psychology ---", geneColor.r, geneColor.g, geneColor.b, 255); y += lineHeight;
-    stringRGBA(renderer, x, y, ("Bravery (Flee thresh): " + float_to_string(entity.getBravery() * 100, 0) + "%").c_str(), statColor.r, statColor.g, statColor.b, 255); y += lineHeight;
-    stringRGBA(renderer, x, y, ("Greed (Eat thresh): " + float_to_string(entity.getGreed() * 100, 0) + "%").c_str(), statColor.r, statColor.g, statColor.b, 255); y += lineHeight * 1.5;
-
-    stringRGBA(renderer, x, y, "--- Genealogie ---", geneColor.r, geneColor.g, geneColor.b, 255); y += lineHeight;
-    stringRGBA(renderer, x, y, ("Gen: " + std::to_string(entity.getGeneration())).c_str(), geneColor.r, geneColor.g, geneColor.b, 255); y += lineHeight;
-    stringRGBA(renderer, x, y, ("P1: " + entity.getParent1Name()).c_str(), linkColor.r, linkColor.g, linkColor.b, 255);
-    panelParent1_rect = {x, y - 2, 250, lineHeight}; y += lineHeight;
-    stringRGBA(renderer, x, y, ("P2: " + entity.getParent2Name()).c_str(), linkColor.r, linkColor.g, linkColor.b, 255);
-    panelParent2_rect = {x, y - 2, 250, lineHeight}; y += lineHeight*1.5;
-
-    stringRGBA(renderer, x, y, "--- Body Stats ---", statColor.r, statColor.g, statColor.b, 255); y += lineHeight;
-    std::string typeStr = "Melee";
-    int eType = entity.getEntityType();
-    if(eType == 1) typeStr = "Ranged"; else if(eType == 2) typeStr = "Healer";
-    stringRGBA(renderer, x, y, ("Type: " + typeStr).c_str(), geneColor.r, geneColor.g, geneColor.b, 255); y += lineHeight;
-    stringRGBA(renderer, x, y, ("Rad (Size): " + std::to_string(entity.getRad())).c_str(), statColor.r, statColor.g, statColor.b, 255); y += lineHeight;
-    stringRGBA(renderer, x, y, ("Speed: " + std::to_string(entity.getSpeed())).c_str(), statColor.r, statColor.g, statColor.b, 255); y += lineHeight;
-    stringRGBA(renderer, x, y, ("Armor: " + float_to_string(entity.getArmor()*100) + "%").c_str(), statColor.r, statColor.g, statColor.b, 255); y += lineHeight*1.5;
-
-    stringRGBA(renderer, x, y, "--- Bio-Traits ---", geneColor.r, geneColor.g, geneColor.b, 255); y += lineHeight;
-    int traitID = entity.getCurrentTraitID();
-    const TraitStats& stats = TraitManager::get(traitID);
-    std::string fullTraitTitle = stats.name;
-    if (entity.getDamageFragility() > 0.10f) fullTraitTitle += " / Weak";
-    if (entity.getMyopiaFactor() > 0.15f)    fullTraitTitle += " / Myopic";
-    if (entity.getFertilityFactor() > 0)     fullTraitTitle += " / Fertile";
-    if (entity.getAgingRate() > 0.0001f)     fullTraitTitle += " / Decaying";
-    if (entity.getAimingPenalty() > 2.0f)    fullTraitTitle += " / Clumsy";
-
-    stringRGBA(renderer, x, y, ("Trait: " + fullTraitTitle).c_str(), titleColor.r, titleColor.g, titleColor.b, 255); y += lineHeight;
-
-    if (traitID != 0 && !stats.description.empty()) {
-        stringRGBA(renderer, x, y, stats.description.c_str(), statColor.r, statColor.g, statColor.b, 255);
-        y += lineHeight;
-    }
-    y += 5;
-    float frag = entity.getDamageFragility() * 100.0f;
-    if(frag > 1.0f) {
-        stringRGBA(renderer, x, y, ("(Weak) Dmg Taken: +" + float_to_string(frag,1) + "%").c_str(), badColor.r, badColor.g, badColor.b, 255);
-        y += lineHeight;
+    // Only occupied cells have work: list them per color once, in row-major order
+    for (auto& cells : collisionCells) cells.clear();
+    for (int cy = 0; cy < entityGrid.getRows(); ++cy) {
+        for (int cx = 0; cx < entityGrid.getCols(); ++cx) {
+            if (entityGrid.getCellPopulation(cx, cy) == 0) continue;
+            collisionCells[(cx & 1) | ((cy & 1) << 1)].push_back(cy * entityGrid.getCols() + cx);
+        }
     }
-    float myop = entity.getMyopiaFactor() * 100.0f;
-    if(myop > 1.0f) {
-        stringRGBA(renderer, x, y, ("(Myopic) Vision: -" + float_to_string(myop,1) + "%").c_str(), badColor.r, badColor.g, badColor.b, 255);
-        y += lineHeight;
+
+    int cols = entityGrid.getCols();
+    auto solveByColor = [&](auto&& solveCell) {
+        for (const auto& cells : collisionCells) {
+            workerPool.parallelFor((int)cells.size(), COLLISION_GRAIN_SIZE, [&](int, int begin, int end) {
+                for (int k = begin; k < end; ++k) solveCell(cells[k] % cols, cells[k] / cols);
+            });
+        }
+    };
+
+    // Stop entities that would have passed through each other this tick, then relax the overlaps
+    solveByColor([this](int cx, int cy) { sweepCollisionCell(cx, cy); });
+    for (int iteration = 0; iteration < collisionIterations; ++iteration) {
+        solveByColor([this](int cx, int cy) { solveCollisionCell(cx, cy); });
     }
-    int fert = entity.getFertilityFactor();
-    if(fert > 0) {
-        stringRGBA(renderer, x, y, "(Fertile) Reproduction Bonus: ++", goodColor.r, goodColor.g, goodColor.b, 255);
-        y += lineHeight;
-        stringRGBA(renderer, x, y, "          Max HP Penalty: -", badColor.r, badColor.g, badColor.b, 255);
-        y += lineHeight;
+
+    // Round (instead of truncating) back to the integer positions of the entities
+    for (int i = 0; i < count; ++i) {
+        if (!next.getIsAlive(i)) continue;
+        int newX = (int)std::lround(solveX[i]);
+        int newY = (int)std::lround(solveY[i]);
+        if (newX == entities[i].getX() && newY == entities[i].getY()) continue;
+        entities[i].setX(newX);
+        entities[i].setY(newY);
+        next.write(i, entities[i]);
     }
-    y += 10;
+}
 
-    stringRGBA(renderer, x, y, "--- Weapon Stats ---", statColor.r, statColor.g, statColor.b, 255); y += lineHeight;
-    stringRGBA(renderer, x, y, ("Damage: " + std::to_string(entity.getDamage())).c_str(), statColor.r, statColor.g, statColor.b, 255); y += lineHeight;
-    stringRGBA(renderer, x, y, ("Range: " + std::to_string(entity.getAttackRange())).c_str(), statColor.r, statColor.g, statColor.b, 255); y += lineHeight;
-    stringRGBA(renderer, x, y, ("Cooldown: " + std::to_string(entity.getAttackCooldown()) + " ms").c_str(), statColor.r, statColor.g, statColor.b, 255); y += lineHeight;
-    stringRGBA(renderer, x, y, ("Stamina Cost: " + std::to_string(entity.getStaminaAttackCost())).c_str(), statColor.r, statColor.g, statColor.b, 255); y += lineHeight;
+// Sweeps the movement of every entity of cell (cx, cy) since the previous tick against the
+// entities of the 3x3 block around it, and pulls it back to its first contact if it went
+// through one of them. Works on relative motion, so two movers meeting head-on both stop.
+void Simulation::sweepCollisionCell(int cx, int cy) {
+    const EntityStore& previous = entityStores[frontStore];
+    const EntityStore& next = entityStores[1 - frontStore];
+    entityGrid.forEachInCell(cx, cy, [&](int a) {
+        float startX = previous.getX(a);
+        float startY = previous.getY(a);
+        float moveX = solveX[a] - startX;
+        float moveY = solveY[a] - startY;
+        int radA = next.getRad(a);
+        float firstContact = 1.0f;
+
+        for (int ny = cy - 1; ny <= cy + 1; ++ny) {
+            for (int nx = cx - 1; nx <= cx + 1; ++nx) {
+                entityGrid.forEachInCell(nx, ny, [&](int b) {
+                    if (b == a) return;
+                    float relStartX = startX - previous.getX(b);
+                    float relStartY = startY - previous.getY(b);
+                    float relEndX = solveX[a] - solveX[b];
+                    float relEndY = solveY[a] - solveY[b];
+                    float reach = (float)(radA + next.getRad(b));
+                    float t = sweepCircle(relStartX, relStartY, relEndX, relEndY, 0.0f, 0.0f, reach);
+                    // t == 0: already overlapping at the start, left to the relaxation passes
+                    if (t > 0.0f && t < firstContact) firstContact = t;
+                });
+            }
+        }
 
-    if (entity.getProjectileSpeed() > 0) {
-        stringRGBA(renderer, x, y, ("Proj Speed: " + std::to_string(entity.getProjectileSpeed())).c_str(), statColor.r, statColor.g, statColor.b, 255); y += lineHeight;
-        stringRGBA(renderer, x, y, ("Proj Radius: " + std::to_string(entity.getProjectileRadius())).c_str(), statColor.r, statColor.g, statColor.b, 255);
-    }
+        if (firstContact < 1.0f) {
+            solveX[a] = startX + moveX * firstContact;
+            solveY[a] = startY + moveY * firstContact;
+        }
+    });
 }
 
-// Updates the state of all projectiles
-void Simulation::updateProjectiles() {
-    projectiles.erase(std::remove_if(projectiles.begin(), projectiles.end(), [&](Projectile& proj) {
-        proj.update();
-        if (!proj.isAlive()) return true;
-        for (auto &entity : entities) {
-            if (entity.getIsAlive()) {
-                if (entity.getName() == proj.getShooterName()) continue;
-                int dx = proj.getX() - entity.getX(); int dy = proj.getY() - entity.getY();
-                float distance = std::sqrt((float)dx * dx + (float)dy * dy);
-                if (distance < proj.getRadius() + entity.getRad()) { entity.takeDamage(proj.getDamage()); return true; }
+// Pushes every entity of cell (cx, cy) out of the entities it overlaps in the 3x3 block around it
+void Simulation::solveCollisionCell(int cx, int cy) {
+    const EntityStore& next = entityStores[1 - frontStore];
+    entityGrid.forEachInCell(cx, cy, [&](int a) {
+        float ax = solveX[a];
+        float ay = solveY[a];
+        int radA = next.getRad(a);
+
+        for (int ny = cy - 1; ny <= cy + 1; ++ny) {
+            for (int nx = cx - 1; nx <= cx + 1; ++nx) {
+                entityGrid.forEachInCell(nx, ny, [&](int b) {
+                    if (b == a) return;
+                    float dx = ax - solveX[b];
+                    float dy = ay - solveY[b];
+                    float minDistance = (float)(radA + next.getRad(b));
+                    float distSq = dx * dx + dy * dy;
+                    if (distSq >= minDistance * minDistance) return;
+
+                    float distance = std::sqrt(distSq);
+                    float separation = (minDistance - distance) * SEPARATION_FACTOR;
+                    if (distance > 0.0f) {
+                        ax += dx / distance * separation;
+                        ay += dy / distance * separation;
+                    } else {
+                        // Exactly stacked: split them along x in index order
+                        ax += (a < b) ? -separation : separation;
+                    }
+                });
             }
         }
-        return false;
-    }), projectiles.end());
+
+        solveX[a] = ax;
+        solveY[a] = ay;
+    });
 }
 
-// Removes dead entities from the simulation
-void Simulation::cleanupDead() {
-    entities.erase(std::remove_if(entities.begin(), entities.end(), [](const Entity &entity) { return !entity.getIsAlive(); }), entities.end());
+// Appends the shots buffered by the workers, ordered by shooter index so that the result
+// does not depend on which worker ran which chunk
+void Simulation::mergeProjectileSpawns() {
+    spawnMergeScratch.clear();
+    for (auto& buffer : projectileSpawns) {
+        spawnMergeScratch.insert(spawnMergeScratch.end(), buffer.begin(), buffer.end());
+        buffer.clear();
+    }
+    std::sort(spawnMergeScratch.begin(), spawnMergeScratch.end(), [](const ProjectileSpawn& a, const ProjectileSpawn& b) {
+        return a.shooterIndex < b.shooterIndex;
+    });
+    for (const auto& spawn : spawnMergeScratch) projectiles.spawn(spawn.shot);
 }
 
-// Renders the simulation, including entities, projectiles, and UI
-void Simulation::render(SDL_Renderer* renderer, bool showDebug, const Camera& cam) {
-    for (const auto& f : foods) {
-        float sx = (f.x - cam.x) * cam.zoom;
-        float sy = (f.y - cam.y) * cam.zoom;
-        float sr = f.radius * cam.zoom;
-        filledCircleRGBA(renderer, (int)sx, (int)sy, (int)sr, 34, 139, 34, 255);
-        circleRGBA(renderer, (int)sx, (int)sy, (int)sr, 144, 238, 144, 200);
+// Applies the interactions recorded by the workers, grouped by target. Sorting on
+// (target, source, kind) fixes the order independently of the worker scheduling.
+void Simulation::applyInteractions() {
+    interactionScratch.clear();
+    for (auto& buffer : interactionBuffers) {
+        interactionScratch.insert(interactionScratch.end(), buffer.begin(), buffer.end());
+        buffer.clear();
     }
-    for (auto &entity : entities) entity.draw(renderer, cam, showDebug);
-    for (auto &proj : projectiles) proj.draw(renderer, cam);
-
-    if (selectedLivingEntity != nullptr) {
-        float sx = (selectedLivingEntity->getX() - cam.x) * cam.zoom;
-        float sy = (selectedLivingEntity->getY() - cam.y) * cam.zoom;
-        float sr = (selectedLivingEntity->getRad() + 4) * cam.zoom;
-        circleRGBA(renderer, (int)sx, (int)sy, (int)sr, 255, 255, 0, 200);
+    std::sort(interactionScratch.begin(), interactionScratch.end(), [](const Interaction& a, const Interaction& b) {
+        if (a.target != b.target) return a.target < b.target;
+        if (a.source != b.source) return a.source < b.source;
+        return a.kind < b.kind;
+    });
+
+    for (const Interaction& interaction : interactionScratch) {
+        Entity& target = entities[interaction.target];
+        switch (interaction.kind) {
+            case Interaction::DAMAGE: target.takeDamage(interaction.amount); break;
+            case Interaction::HEAL: target.receiveHealing(interaction.amount); break;
+            case Interaction::KNOCKBACK: target.knockBackFrom(interaction.sourceX, interaction.sourceY, interaction.amount); break;
+        }
+        entityStores[1 - frontStore].write(interaction.target, target);
     }
+}
 
-    if (panelCurrentX < WINDOW_WIDTH) drawStatsPanel(renderer, static_cast<int>(panelCurrentX));
+// Moves every projectile and resolves its hit, in parallel over projectiles. Each projectile
+// only tests the entities of the grid cells around its path and keeps the earliest hit, and
+// the damage goes through the interaction buffers so it is applied in a deterministic order.
+void Simulation::updateProjectiles() {
+    if (projectiles.size() == 0) return;
+    const EntityStore& next = entityStores[1 - frontStore];
+    entityGrid.rebuild(next);
+
+    int maxEntityRad = 0;
+    for (int i = 0; i < next.size(); ++i) {
+        if (next.getIsAlive(i)) maxEntityRad = std::max(maxEntityRad, next.getRad(i));
+    }
+
+    workerPool.parallelFor(projectiles.size(), PROJECTILE_GRAIN_SIZE, [&](int worker, int begin, int end) {
+        projectiles.integrate(begin, end);
+
+        for (int p = begin; p < end; ++p) {
+            // Swept test along this tick's segment, so a fast projectile cannot skip over an entity.
+            // A projectile that runs out of range this tick still hits along its last segment.
+            float x0 = projectiles.getPrevX(p), y0 = projectiles.getPrevY(p);
+            float x1 = projectiles.getX(p), y1 = projectiles.getY(p);
+            int projRadius = projectiles.getRadius(p);
+            float halfLength = 0.5f * std::sqrt((x1 - x0) * (x1 - x0) + (y1 - y0) * (y1 - y0));
+            float queryRadius = halfLength + (float)(projRadius + maxEntityRad);
+
+            int hitIdx = -1;
+            float hitTime = 2.0f;
+            entityGrid.forEachInRadius(0.5f * (x0 + x1), 0.5f * (y0 + y1), queryRadius, [&](int idx) {
+                float reach = (float)(projRadius + next.getRad(idx));
+                float t = sweepCircle(x0, y0, x1, y1, next.getX(idx), next.getY(idx), reach);
+                if (t < 0.0f || t > hitTime || (t == hitTime && idx > hitIdx)) return;
+                if (entities[idx].getId() == projectiles.getShooterId(p)) return;
+                hitIdx = idx;
+                hitTime = t;
+            });
+
+            if (hitIdx != -1) {
+                interactionBuffers[worker].push_back({hitIdx, p, Interaction::DAMAGE, projectiles.getDamage(p), 0, 0});
+                projectiles.kill(p);
+            }
+        }
+    });
+
+    projectiles.removeDead();
+    applyInteractions();
+}
+
+// Removes dead entities from the simulation (and their slots of the next snapshot)
+void Simulation::cleanupDead() {
+    entityStores[1 - frontStore].removeDead(entities);
+    size_t before = entities.size();
+    entities.erase(std::remove_if(entities.begin(), entities.end(), [](const Entity &entity) { return !entity.getIsAlive(); }), entities.end());
+    if (entities.size() != before) neighborLists.invalidate(); // The lists hold the old indices
 }
 
 // Spawns food items in the simulation
 void Simulation::spawnFood() {
-    if (foods.size() < MAX_FOOD_COUNT && (rand() % 100 < FOOD_SPAWN_RATE)) {
-        Food f;
-        f.x = 20 + (rand() % (WORLD_WIDTH - 40));
-        f.y = 20 + (rand() % (WORLD_HEIGHT - 40));
-        foods.push_back(f);
+    if (foods.size() < MAX_FOOD_COUNT && rng.nextInt(100) < FOOD_SPAWN_RATE) {
+        FoodPool::Food f;
+        f.x = 20 + rng.nextInt(WORLD_WIDTH - 40);
+        f.y = 20 + rng.nextInt(WORLD_HEIGHT - 40);
+        foods.add(f);
     }
 }
 
 // Updates the state of food items, including consumption by entities
-void Simulation::updateFood(int speedMultiplier) {
-    auto it = foods.begin();
-    while (it != foods.end()) {
-        bool eaten = false;
-        for (auto &entity : entities) {
-            if (!entity.getIsAlive()) continue;
-
-            int dx = entity.getX() - it->x;
-            int dy = entity.getY() - it->y;
+// Each entity only looks at the food buckets it overlaps. Entities are visited in index order,
+// so a food item touched by several entities still goes to the lowest index
+void Simulation::updateFood() {
+    if (foods.size() == 0) return;
+    for (auto &entity : entities) {
+        if (!entity.getIsAlive()) continue;
+        float reach = (float)(entity.getRad() + FOOD_MAX_RADIUS);
+        foods.forEachInRadius((float)entity.getX(), (float)entity.getY(), reach, [&](int k) {
+            const FoodPool::Food& food = foods.get(k);
+            int dx = entity.getX() - food.x;
+            int dy = entity.getY() - food.y;
             float dist = std::sqrt((float)(dx*dx + dy*dy));
 
-            if (dist < (entity.getRad() + it->radius)) {
-                entity.restoreStamina(50, speedMultiplier);
-                eaten = true;
-                break;
+            if (dist < (entity.getRad() + food.radius)) {
+                entity.restoreStamina(FOOD_STAMINA_GAIN);
+                lastFeedTicks[entity.getId().index - 1] = currentTick;
+                foods.remove(k);
             }
-        }
-        if (eaten) {
-            it = foods.erase(it);
-        } else {
-            ++it;
-        }
+        });
     }
 }
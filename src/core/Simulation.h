@@ -2,15 +2,24 @@
 #define EVOARENA_SIMULATION_H
 
 #include <vector>
+#include <array>
+#include <algorithm>
 #include <map>
 #include <string>
-#include <SDL2/SDL.h>
-#include <thread>
-#include <mutex>
+#include <cstdint>
 #include "../Entity/Entity.h"
-#include "../Entity/Projectile.h"
+#include "../Entity/Lineage.h"
+#include "ProjectilePool.h"
+#include "FoodPool.h"
+#include "EntityStore.h"
+#include "SpatialGrid.h"
+#include "NeighborLists.h"
+#include "ThreadPool.h"
+#include "SimClock.h"
+#include "Random.h"
 
-// Manages the simulation, including entities, projectiles, and game logic
+// Manages the simulation, including entities, projectiles, and game logic.
+// Has no windowing dependency: rendering and input live in the front-end (SimulationView).
 class Simulation {
 public:
     // Status of the simulation update
@@ -20,17 +29,13 @@ public:
     };
 
     // Constructor and destructor
-    explicit Simulation(int maxEntities);
+    // threadCount 0 = one worker per hardware thread, seed 0 = seeded from the current time
+    explicit Simulation(int maxEntities, unsigned int threadCount = 0, unsigned int seed = 0);
     ~Simulation();
 
-    // Updates the simulation state
-    SimUpdateStatus update(int speedMultiplier, bool autoRestart);
-
-    // Handles user input events
-    void handleEvent(const SDL_Event& event, const Camera& cam);
-
-    // Renders the simulation
-    void render(SDL_Renderer* renderer, bool showDebug, const Camera& cam);
+    // Advances the simulation by one fixed-length tick (SIM_TICK_MS).
+    // Running faster means calling this more often, never stretching a tick.
+    SimUpdateStatus update(bool autoRestart);
 
     // Restarts the simulation manually
     void triggerManualRestart();
@@ -38,49 +43,185 @@ public:
     // Returns the current generation number
     int getCurrentGeneration() const { return currentGeneration; }
 
+    // Index of the next tick to simulate
+    SimTick getCurrentTick() const { return currentTick; }
+
+    // Incremented every time the population is replaced (new generation or reset)
+    int getPopulationEpoch() const { return populationEpoch; }
+
+    // Read access for the front-ends
+    const std::vector<Entity>& getEntities() const { return entities; }
+    const ProjectilePool& getProjectiles() const { return projectiles; }
+    const FoodPool& getFoods() const { return foods; }
+
+    // Returns an archived survivor by id, or nullptr if it was never archived
+    const Entity* findArchivedEntity(EntityId id) const;
+
+    // Lineage of a living or archived entity, or nullptr if unknown
+    const Lineage* findLineage(EntityId id) const;
+
+    // Tick of the last meal of a living entity (used by the renderer for the flash effect)
+    static constexpr SimTick NEVER_FED = -1000000;
+    SimTick getLastFeedTick(EntityId id) const;
+
+    // Returns the per-worker busy/idle time of the last tick
+    const std::vector<ThreadPool::WorkerStats>& getWorkerStats() const { return workerPool.getStats(); }
+
+    // Number of workers used for the parallel update
+    unsigned int getThreadCount() const { return workerPool.getThreadCount(); }
+
+    // Relaxation passes of the collision phase (0 disables overlap separation)
+    void setCollisionIterations(int iterations) { collisionIterations = std::max(0, iterations); }
+    int getCollisionIterations() const { return collisionIterations; }
+
+    // Time spent in the update kernel of each role during the last tick
+    struct RoleStats {
+        double updateMs = 0.0;  // Wall time of the role's parallel update
+        int entities = 0;       // Living entities of that role
+    };
+    const std::array<RoleStats, Entity::ROLE_COUNT>& getRoleStats() const { return roleStats; }
+
+    // Wall time of the last generation rollover (parallel reproduction and clan assignment)
+    double getReproductionMs() const { return reproductionMs; }
+
+    // Neighbour list rebuilds since construction, and whether the last tick rebuilt them
+    long long getNeighborListRebuilds() const { return neighborLists.getRebuildCount(); }
+    bool wereNeighborListsRebuilt() const { return neighborListsRebuilt; }
+
 private:
     // Simulation state
     int currentGeneration = 0;
+    int populationEpoch = 0;
+    SimTick currentTick = 0;
     int maxEntities;
+    std::uint64_t seed;
     std::vector<Entity> entities;
-    std::vector<Projectile> projectiles;
-    std::map<std::string, Uint32> lastShotTime;
-    std::map<std::string, Entity> genealogyArchive;
-    Entity* selectedLivingEntity;
-    std::vector<Entity> inspectionStack;
+    ProjectilePool projectiles;
+    std::map<EntityId, Entity> genealogyArchive;
     std::vector<Entity> lastSurvivors;
 
-    // Mutex for thread safety
-    std::mutex simMutex;
+    // Cold side tables of the current population, indexed by EntityId::index - 1 (stable for the
+    // whole generation, unlike the positions in 'entities'), and the lineages of archived survivors
+    std::vector<Lineage> lineages;
+    std::vector<SimTick> lastFeedTicks;
+    std::map<EntityId, Lineage> archivedLineages;
+
+    // Reproduction buffers, swapped with entities/lineages at each rollover so that their
+    // capacity is reused from one generation to the next
+    std::vector<Entity> nextGeneration;
+    std::vector<Lineage> nextLineages;
+    std::vector<int> ticketEnds;   // Cumulative lottery tickets of the parents
+    double reproductionMs = 0.0;
 
-    // UI panel state
-    float panelTargetX;
-    float panelCurrentX;
-    SDL_Rect panelParent1_rect{};
-    SDL_Rect panelParent2_rect{};
-    SDL_Rect panelBack_rect{};
+    // Double-buffered hot fields: workers read entityStores[frontStore] (end of the previous
+    // tick) and write their own entities' slots of the other one, swapped at the end of the tick
+    EntityStore entityStores[2];
+    int frontStore = 0;
+    int snapshotEpoch = -1;
 
-    // Food system
-    struct Food {
-        int x, y;
-        int radius = 4;
+    // Living entity indices grouped by role, rebuilt every tick: role r owns
+    // roleItems[roleStart[r], roleStart[r + 1])
+    std::array<int, Entity::ROLE_COUNT + 1> roleStart{};
+    std::vector<int> roleItems;
+    std::array<RoleStats, Entity::ROLE_COUNT> roleStats{};
+
+    // Spatial index of living entities, rebuilt once per tick
+    SpatialGrid entityGrid;
+
+    // Perception candidates of each entity, reused across ticks until they go stale
+    NeighborLists neighborLists;
+    bool neighborListsRebuilt = false;
+
+    // Clans of the current population and the wounded non-healers of each clan (rebuilt every
+    // tick from the snapshot, laid out like the grid buckets), so healers never filter everyone
+    int clanCount = 0;
+    std::vector<int> clanWoundedStart;      // Offset of each clan in clanWoundedItems (clanCount + 1 entries)
+    std::vector<int> clanWoundedItems;      // Entity indices grouped by clan
+    std::vector<int> clanWoundedCursor;     // Scratch: next free slot of each clan during the rebuild
+
+    // Candidates of one perception query gathered as contiguous arrays for the distance kernels
+    // (one per worker, sized once for the whole population so gathering never allocates)
+    struct PerceptionScratch {
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<std::uint8_t> mask;
+
+        void resize(int count) {
+            x.resize(count);
+            y.resize(count);
+            mask.resize(count);
+        }
+    };
+    std::vector<PerceptionScratch> perceptionScratch;
+
+    // Stream for the serial phases (population setup, reproduction, food spawning).
+    // The parallel phase keys a fresh stream per (entity, tick) instead.
+    RandomStream rng;
+
+    // Persistent workers for the parallel update phase
+    ThreadPool workerPool;
+
+    // Shot fired during the parallel phase, tagged with the shooter's index for the merge
+    struct ProjectileSpawn {
+        int shooterIndex;
+        ProjectilePool::Spawn shot;
+    };
+
+    // Collision phase: number of passes and the float positions being relaxed
+    int collisionIterations = 2;
+    std::vector<float> solveX;
+    std::vector<float> solveY;
+    std::vector<int> collisionCells[4];     // Occupied cells of each color
+
+    // Per-worker shot buffers (indexed by worker) and the scratch used to merge them
+    std::vector<std::vector<ProjectileSpawn>> projectileSpawns;
+    std::vector<ProjectileSpawn> spawnMergeScratch;
+
+    // Effect on an entity (melee hit, heal, knockback, projectile hit), recorded by a worker
+    // instead of writing into an entity that another worker may be updating
+    struct Interaction {
+        enum Kind : std::uint8_t { DAMAGE, HEAL, KNOCKBACK };
+        int target;             // Index of the affected entity
+        int source;             // Index of the acting entity (of the projectile for projectile hits)
+        Kind kind;
+        int amount;             // Damage or heal points, knockback force
+        int sourceX, sourceY;   // Position the knockback pushes away from
     };
-    std::vector<Food> foods;
+
+    // Per-worker interaction buffers (indexed by worker) and the scratch used to sort them
+    std::vector<std::vector<Interaction>> interactionBuffers;
+    std::vector<Interaction> interactionScratch;
+
+
+    // Food system, bucketed by cell for perception and consumption
+    FoodPool foods;
 
     // Food parameters
     const int MAX_FOOD_COUNT = 60;
     const int FOOD_SPAWN_RATE = 5;
     const int FOOD_STAMINA_GAIN = 50;
+    const int FOOD_MAX_RADIUS = 4;      // Largest food radius, bounds the consumption search
 
     // Private helper functions
     void initialize(int initialEntityCount);
     void triggerReproduction(const std::vector<Entity>& parents);
-    void drawStatsPanel(SDL_Renderer* renderer, int panelX);
-    void updateLogicAndPhysicsRange(int startIdx, int endIdx, int speedMultiplier);
+    int drawParent(RandomStream& childRng) const;
+    void breedChild(const std::vector<Entity>& parents, int childIndex);
+    void assignClans();
+    void rebuildWoundedAllies();
+    void rebuildNeighborListsIfStale();
+    void partitionByRole();
+    template <int Role> void runRoleUpdate();
+    template <int Role> void updateRoleRange(int worker, int begin, int end);
+    void mergeProjectileSpawns();
+    void applyInteractions();
+    void resolveCollisions();
+    void sweepCollisionCell(int cx, int cy);
+    void solveCollisionCell(int cx, int cy);
     void updateProjectiles();
     void cleanupDead();
     void spawnFood();
-    void updateFood(int speedMultiplier);
+    void updateFood();
 };
 
 #endif //EVOARENA_SIMULATION_H
@@ -0,0 +1,34 @@
+#include "SpatialGrid.h"
+#include "../constants.h"
+
+// Constructor: Stores the cell size, buckets are allocated on the first rebuild
+SpatialGrid::SpatialGrid(int cellSize) : cellSize(std::max(1, cellSize)) {}
+
+// Rebuilds the buckets with a counting sort (count, prefix sum, scatter)
+void SpatialGrid::rebuild(const EntityStore& store) {
+    cols = std::max(1, (WORLD_WIDTH + cellSize - 1) / cellSize);
+    rows = std::max(1, (WORLD_HEIGHT + cellSize - 1) / cellSize);
+    int cellCount = cols * rows;
+
+    cellStart.assign(cellCount + 1, 0);
+    itemCell.resize(store.size());
+
+    // Count entities per cell
+    for (int i = 0; i < store.size(); ++i) {
+        if (!store.getIsAlive(i)) { itemCell[i] = -1; continue; }
+        int cell = cellCoord(store.getY(i), rows) * cols + cellCoord(store.getX(i), cols);
+        itemCell[i] = cell;
+        cellStart[cell + 1]++;
+    }
+
+    // Prefix sum gives the first slot of each cell
+    for (int c = 0; c < cellCount; ++c) cellStart[c + 1] += cellStart[c];
+
+    // Scatter indices, keeping ascending entity order inside each cell
+    cellItems.resize(cellStart[cellCount]);
+    cellCursor.assign(cellStart.begin(), cellStart.end() - 1);
+    for (int i = 0; i < store.size(); ++i) {
+        if (itemCell[i] < 0) continue;
+        cellItems[cellCursor[itemCell[i]]++] = i;
+    }
+}
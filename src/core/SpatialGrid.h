@@ -0,0 +1,116 @@
+#ifndef EVOARENA_SPATIALGRID_H
+#define EVOARENA_SPATIALGRID_H
+
+#include <vector>
+#include <algorithm>
+#include "EntityStore.h"
+
+// Uniform grid over the world used to limit neighbour searches to nearby cells.
+// Buckets are stored as a flat counting-sort layout (cellStart + cellItems) and
+// rebuilt once per tick, so queries never allocate.
+class SpatialGrid {
+public:
+    explicit SpatialGrid(int cellSize = 128);
+
+    // Rebuilds the buckets from the living entities' captured positions
+    void rebuild(const EntityStore& store);
+
+    // Calls fn(index) for every bucketed entity whose cell overlaps the circle (x, y, radius).
+    // Candidates are not distance-filtered: the caller still has to test the exact distance.
+    template <typename Fn>
+    void forEachInRadius(float x, float y, float radius, Fn&& fn) const {
+        if (cols == 0) return;
+        int minCX = cellCoord(x - radius, cols);
+        int maxCX = cellCoord(x + radius, cols);
+        int minCY = cellCoord(y - radius, rows);
+        int maxCY = cellCoord(y + radius, rows);
+
+        for (int cy = minCY; cy <= maxCY; ++cy) {
+            for (int cx = minCX; cx <= maxCX; ++cx) {
+                int cell = cy * cols + cx;
+                for (int k = cellStart[cell]; k < cellStart[cell + 1]; ++k) fn(cellItems[k]);
+            }
+        }
+    }
+
+    // Returns the index of the closest bucketed entity accepted by the filter, or -1 if none.
+    // Rings of cells are visited outwards from the query cell and the search stops as soon as
+    // the next ring cannot contain anything closer, so there is no distance limit.
+    template <typename Accept>
+    int findNearest(const EntityStore& store, float x, float y, Accept&& accept) const {
+        if (cols == 0) return -1;
+        int qx = cellCoord(x, cols);
+        int qy = cellCoord(y, rows);
+        int best = -1;
+        float bestSq = 0.0f;
+        int maxRing = std::max(std::max(qx, cols - 1 - qx), std::max(qy, rows - 1 - qy));
+
+        auto visitCell = [&](int cx, int cy) {
+            if (cx < 0 || cx >= cols || cy < 0 || cy >= rows) return;
+            int cell = cy * cols + cx;
+            for (int k = cellStart[cell]; k < cellStart[cell + 1]; ++k) {
+                int idx = cellItems[k];
+                if (!accept(idx)) continue;
+                float dx = store.getX(idx) - x;
+                float dy = store.getY(idx) - y;
+                float distSq = dx * dx + dy * dy;
+                if (best == -1 || distSq < bestSq || (distSq == bestSq && idx < best)) {
+                    best = idx;
+                    bestSq = distSq;
+                }
+            }
+        };
+
+        for (int ring = 0; ring <= maxRing; ++ring) {
+            // Every cell of this ring is at least (ring - 1) cells away from the query point
+            if (best != -1 && ring > 1) {
+                float ringMinDist = (float)((ring - 1) * cellSize);
+                if (ringMinDist * ringMinDist > bestSq) break;
+            }
+            if (ring == 0) { visitCell(qx, qy); continue; }
+            for (int cx = qx - ring; cx <= qx + ring; ++cx) {
+                visitCell(cx, qy - ring);
+                visitCell(cx, qy + ring);
+            }
+            for (int cy = qy - ring + 1; cy <= qy + ring - 1; ++cy) {
+                visitCell(qx - ring, cy);
+                visitCell(qx + ring, cy);
+            }
+        }
+        return best;
+    }
+
+    // Calls fn(index) for every entity bucketed in cell (cx, cy); out-of-range cells are empty
+    template <typename Fn>
+    void forEachInCell(int cx, int cy, Fn&& fn) const {
+        if (cx < 0 || cx >= cols || cy < 0 || cy >= rows) return;
+        int cell = cy * cols + cx;
+        for (int k = cellStart[cell]; k < cellStart[cell + 1]; ++k) fn(cellItems[k]);
+    }
+
+    // Number of entities bucketed in cell (cx, cy) (in range)
+    int getCellPopulation(int cx, int cy) const {
+        int cell = cy * cols + cx;
+        return cellStart[cell + 1] - cellStart[cell];
+    }
+
+    int getCellSize() const { return cellSize; }
+    int getCols() const { return cols; }
+    int getRows() const { return rows; }
+
+private:
+    // Converts a world coordinate to a clamped cell coordinate
+    int cellCoord(float v, int count) const {
+        return std::clamp((int)(v / (float)cellSize), 0, count - 1);
+    }
+
+    int cellSize;
+    int cols = 0;
+    int rows = 0;
+    std::vector<int> cellStart;  // Offset of each cell in cellItems (cols * rows + 1 entries)
+    std::vector<int> cellItems;  // Entity indices grouped by cell
+    std::vector<int> itemCell;   // Scratch: cell of each entity during rebuild (-1 if skipped)
+    std::vector<int> cellCursor; // Scratch: next free slot of each cell during rebuild
+};
+
+#endif //EVOARENA_SPATIALGRID_H
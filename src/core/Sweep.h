@@ -0,0 +1,31 @@
+#ifndef EVOARENA_SWEEP_H
+#define EVOARENA_SWEEP_H
+
+#include <cmath>
+
+// Time of first contact, in [0, 1], of a point moving from (x0, y0) to (x1, y1) with a circle
+// of radius reach centred on (cx, cy). Two moving circles reduce to this by using the sum of
+// their radii as reach (and relative coordinates when both move).
+// Returns 0 if the point starts inside the circle and -1 if the segment never touches it.
+inline float sweepCircle(float x0, float y0, float x1, float y1, float cx, float cy, float reach) {
+    float fx = x0 - cx;
+    float fy = y0 - cy;
+    float c = fx * fx + fy * fy - reach * reach;
+    if (c <= 0.0f) return 0.0f;
+
+    float dx = x1 - x0;
+    float dy = y1 - y0;
+    float a = dx * dx + dy * dy;
+    if (a <= 0.0f) return -1.0f;
+
+    float b = fx * dx + fy * dy;
+    if (b >= 0.0f) return -1.0f; // Moving away from the centre
+
+    float discriminant = b * b - a * c;
+    if (discriminant < 0.0f) return -1.0f;
+
+    float t = (-b - std::sqrt(discriminant)) / a;
+    return (t <= 1.0f) ? t : -1.0f;
+}
+
+#endif //EVOARENA_SWEEP_H
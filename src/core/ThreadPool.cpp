@@ -0,0 +1,160 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+namespace {
+    // Packs a [head, tail) chunk range into one word (head in the low half)
+    std::uint64_t packRange(std::uint32_t head, std::uint32_t tail) {
+        return ((std::uint64_t)tail << 32) | head;
+    }
+
+    double elapsedMs(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+        return std::chrono::duration<double, std::milli>(to - from).count();
+    }
+}
+
+// Constructor: Spawns the pooled threads once (the caller is worker 0)
+ThreadPool::ThreadPool(unsigned int threadCount) : threadCount(threadCount) {
+    if (this->threadCount == 0) this->threadCount = std::thread::hardware_concurrency();
+    if (this->threadCount == 0) this->threadCount = 2;
+
+    queues = std::vector<WorkerQueue>(this->threadCount);
+    stats.resize(this->threadCount);
+    finishTimes.resize(this->threadCount);
+
+    threads.reserve(this->threadCount - 1);
+    for (unsigned int i = 1; i < this->threadCount; ++i) {
+        threads.emplace_back([this, i]() { workerLoop((int)i); });
+    }
+}
+
+// Destructor: Wakes every parked worker and joins them
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+    for (auto& t : threads) {
+        if (t.joinable()) t.join();
+    }
+}
+
+// Clears the per-worker time accounting
+void ThreadPool::resetStats() {
+    std::fill(stats.begin(), stats.end(), WorkerStats{});
+}
+
+// Deals the chunks out to the workers, runs the caller's share and waits for the others
+void ThreadPool::parallelFor(int count, int grainSize, const Job& job) {
+    if (count <= 0) return;
+    grainSize = std::max(1, grainSize);
+    int chunkCount = (count + grainSize - 1) / grainSize;
+
+    // Not enough work to share: waking the pool would cost more than the job itself
+    if (threads.empty() || count < (int)threadCount || chunkCount == 1) {
+        Clock::time_point start = Clock::now();
+        job(0, 0, count);
+        stats[0].busyMs += elapsedMs(start, Clock::now());
+        stats[0].chunksRun++;
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        currentJob = &job;
+        currentCount = count;
+        currentGrain = grainSize;
+        for (unsigned int w = 0; w < threadCount; ++w) {
+            auto head = (std::uint32_t)((long long)chunkCount * w / threadCount);
+            auto tail = (std::uint32_t)((long long)chunkCount * (w + 1) / threadCount);
+            queues[w].range.store(packRange(head, tail), std::memory_order_relaxed);
+        }
+        pendingWorkers = (int)threads.size();
+        jobStart = Clock::now();
+        jobGeneration++;
+    }
+    wakeCondition.notify_all();
+
+    runWorker(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCondition.wait(lock, [this]() { return pendingWorkers == 0; });
+    currentJob = nullptr;
+
+    // Whatever a worker did not spend in chunks was spent waking up or waiting at the join
+    double jobMs = elapsedMs(jobStart, Clock::now());
+    for (unsigned int w = 0; w < threadCount; ++w) {
+        stats[w].idleMs += jobMs - elapsedMs(jobStart, finishTimes[w]);
+    }
+}
+
+// Pops the first chunk of a queue (owner side)
+int ThreadPool::popFront(WorkerQueue& queue) {
+    std::uint64_t range = queue.range.load(std::memory_order_acquire);
+    while (true) {
+        auto head = (std::uint32_t)range;
+        auto tail = (std::uint32_t)(range >> 32);
+        if (head >= tail) return -1;
+        if (queue.range.compare_exchange_weak(range, packRange(head + 1, tail), std::memory_order_acq_rel)) {
+            return (int)head;
+        }
+    }
+}
+
+// Pops the last chunk of a queue (thief side)
+int ThreadPool::popBack(WorkerQueue& queue) {
+    std::uint64_t range = queue.range.load(std::memory_order_acquire);
+    while (true) {
+        auto head = (std::uint32_t)range;
+        auto tail = (std::uint32_t)(range >> 32);
+        if (head >= tail) return -1;
+        if (queue.range.compare_exchange_weak(range, packRange(head, tail - 1), std::memory_order_acq_rel)) {
+            return (int)(tail - 1);
+        }
+    }
+}
+
+// Processes the worker's own chunks first, then steals from the other workers
+void ThreadPool::runWorker(int workerIndex) {
+    WorkerStats& own = stats[workerIndex];
+    Clock::time_point busyStart = Clock::now();
+
+    while (true) {
+        int chunk = popFront(queues[workerIndex]);
+        if (chunk < 0) {
+            for (unsigned int k = 1; k < threadCount && chunk < 0; ++k) {
+                chunk = popBack(queues[(workerIndex + k) % threadCount]);
+            }
+            if (chunk < 0) break;
+            own.chunksStolen++;
+        }
+
+        int begin = chunk * currentGrain;
+        int end = std::min(currentCount, begin + currentGrain);
+        (*currentJob)(workerIndex, begin, end);
+        own.chunksRun++;
+    }
+
+    finishTimes[workerIndex] = Clock::now();
+    own.busyMs += elapsedMs(busyStart, finishTimes[workerIndex]);
+}
+
+// Parks until a new job generation is published, runs it, then reports completion
+void ThreadPool::workerLoop(int workerIndex) {
+    std::uint64_t seenGeneration = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeCondition.wait(lock, [&]() { return stopping || jobGeneration != seenGeneration; });
+            if (stopping) return;
+            seenGeneration = jobGeneration;
+        }
+
+        runWorker(workerIndex);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--pendingWorkers == 0) doneCondition.notify_one();
+        }
+    }
+}
@@ -0,0 +1,90 @@
+#ifndef EVOARENA_THREADPOOL_H
+#define EVOARENA_THREADPOOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Long-lived pool of worker threads used to run the per-tick parallel phases.
+// Workers are created once and park on a condition variable between jobs; the
+// calling thread takes part in every job as worker 0.
+//
+// Jobs are cut into small chunks. Each worker starts on its own contiguous share
+// of chunks and, once it runs dry, steals chunks from the back of the others' shares.
+class ThreadPool {
+public:
+    // Job signature: worker index and the [begin, end) range of items to process
+    using Job = std::function<void(int worker, int begin, int end)>;
+
+    // Time accounting of one worker, accumulated over the jobs since the last reset
+    struct WorkerStats {
+        double busyMs = 0.0;    // Time spent inside job chunks
+        double idleMs = 0.0;    // Time spent waking up or waiting for the other workers
+        int chunksRun = 0;      // Chunks processed
+        int chunksStolen = 0;   // Chunks taken from another worker's share
+    };
+
+    // Constructor and destructor (threadCount 0 = one worker per hardware thread)
+    explicit ThreadPool(unsigned int threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Processes [0, count) in chunks of grainSize items and blocks until every chunk is done.
+    // Runs inline on the caller when there are fewer items than workers.
+    void parallelFor(int count, int grainSize, const Job& job);
+
+    // Clears the per-worker time accounting (typically once per tick)
+    void resetStats();
+
+    // Per-worker time accounting since the last reset
+    const std::vector<WorkerStats>& getStats() const { return stats; }
+
+    // Number of workers, including the calling thread
+    unsigned int getThreadCount() const { return threadCount; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // Chunk range [head, tail) of one worker, packed in a single word so that the owner
+    // (popping the front) and thieves (popping the back) synchronise with one CAS
+    struct alignas(64) WorkerQueue {
+        std::atomic<std::uint64_t> range{0};
+    };
+
+    // Main loop of a pooled thread
+    void workerLoop(int workerIndex);
+
+    // Processes the worker's own chunks, then steals until no chunk is left anywhere
+    void runWorker(int workerIndex);
+
+    // Pops a chunk index from the front or the back of a queue (-1 when empty)
+    static int popFront(WorkerQueue& queue);
+    static int popBack(WorkerQueue& queue);
+
+    unsigned int threadCount;
+    std::vector<std::thread> threads;
+    std::vector<WorkerQueue> queues;
+    std::vector<WorkerStats> stats;
+    std::vector<Clock::time_point> finishTimes;
+
+    // Job hand-off state (guarded by mutex)
+    std::mutex mutex;
+    std::condition_variable wakeCondition;
+    std::condition_variable doneCondition;
+    std::uint64_t jobGeneration = 0;
+    int pendingWorkers = 0;
+    bool stopping = false;
+    const Job* currentJob = nullptr;
+    int currentCount = 0;
+    int currentGrain = 1;
+    Clock::time_point jobStart;
+};
+
+#endif //EVOARENA_THREADPOOL_H
@@ -0,0 +1,5 @@
+#include "../constants.h"
+
+// World dimensions shared by the simulation core and the front-ends
+int WORLD_WIDTH = 5000;
+int WORLD_HEIGHT = 5000;
@@ -0,0 +1,146 @@
+#include "core/Simulation.h"
+#include "core/DistanceKernels.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Headless runner: evolves the population without any window and reports throughput.
+//
+// Usage: EvoArenaHeadless [--generations N] [--entities N] [--seed S] [--threads T] [--max-ticks N]
+//                         [--collision-iterations N]
+
+namespace {
+    struct Options {
+        int generations = 10;
+        int entities = 100;
+        unsigned int seed = 1;
+        unsigned int threads = 0;
+        long long maxTicks = 10000000;
+        int collisionIterations = 2;
+    };
+
+    void printUsage() {
+        std::cout << "Usage: EvoArenaHeadless [--generations N] [--entities N] [--seed S] [--threads T] [--max-ticks N] [--collision-iterations N]\n"
+                  << "  --generations  Generations to evolve (default 10)\n"
+                  << "  --entities     Population size (default 100)\n"
+                  << "  --seed         Random seed, 0 = time based (default 1)\n"
+                  << "  --threads      Worker threads, 0 = hardware concurrency (default 0)\n"
+                  << "  --max-ticks    Safety cap on the total number of ticks (default 10000000)\n"
+                  << "  --collision-iterations  Overlap relaxation passes per tick (default 2)" << std::endl;
+    }
+
+    // Parses the command line, returns false on invalid input
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--help" || arg == "-h") return false;
+            if (i + 1 >= argc) {
+                std::cerr << "[Headless] Missing value for " << arg << std::endl;
+                return false;
+            }
+            std::string value = argv[++i];
+            try {
+                if (arg == "--generations") options.generations = std::stoi(value);
+                else if (arg == "--entities") options.entities = std::stoi(value);
+                else if (arg == "--seed") options.seed = (unsigned int)std::stoul(value);
+                else if (arg == "--threads") options.threads = (unsigned int)std::stoul(value);
+                else if (arg == "--max-ticks") options.maxTicks = std::stoll(value);
+                else if (arg == "--collision-iterations") options.collisionIterations = std::stoi(value);
+                else {
+                    std::cerr << "[Headless] Unknown option " << arg << std::endl;
+                    return false;
+                }
+            } catch (const std::exception&) {
+                std::cerr << "[Headless] Invalid value for " << arg << ": " << value << std::endl;
+                return false;
+            }
+        }
+        return options.generations > 0 && options.entities > 1 && options.maxTicks > 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    Simulation simulation(options.entities, options.threads, options.seed);
+    simulation.setCollisionIterations(options.collisionIterations);
+    std::cout << "[Headless] entities=" << options.entities << " seed=" << options.seed
+              << " threads=" << simulation.getThreadCount() << " generations=" << options.generations
+              << " distance kernel=" << getDistanceKernelName() << std::endl;
+
+    std::vector<ThreadPool::WorkerStats> workerTotals(simulation.getThreadCount());
+    double roleMs[Entity::ROLE_COUNT] = {};
+    long long roleUpdates[Entity::ROLE_COUNT] = {};
+    double reproductionMs = 0.0;
+    int generationsDone = 0;
+    long long ticks = 0;
+    long long generationStartTick = 0;
+    int epoch = simulation.getPopulationEpoch();
+
+    auto start = std::chrono::steady_clock::now();
+    while (generationsDone < options.generations && ticks < options.maxTicks) {
+        simulation.update(true);
+        ticks++;
+
+        const auto& workerStats = simulation.getWorkerStats();
+        for (size_t w = 0; w < workerStats.size() && w < workerTotals.size(); ++w) {
+            workerTotals[w].busyMs += workerStats[w].busyMs;
+            workerTotals[w].idleMs += workerStats[w].idleMs;
+            workerTotals[w].chunksStolen += workerStats[w].chunksStolen;
+        }
+        for (int r = 0; r < Entity::ROLE_COUNT; ++r) {
+            roleMs[r] += simulation.getRoleStats()[r].updateMs;
+            roleUpdates[r] += simulation.getRoleStats()[r].entities;
+        }
+
+        // Every population replacement closes a generation
+        if (simulation.getPopulationEpoch() != epoch) {
+            epoch = simulation.getPopulationEpoch();
+            generationsDone++;
+            reproductionMs += simulation.getReproductionMs();
+            std::cout << "[Headless] Generation " << generationsDone << " finished after "
+                      << (ticks - generationStartTick) << " ticks (now G" << simulation.getCurrentGeneration() << ")" << std::endl;
+            generationStartTick = ticks;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (seconds <= 0.0) seconds = 1e-9;
+
+    if (ticks >= options.maxTicks) {
+        std::cout << "[Headless] Stopped at the tick cap (" << options.maxTicks << ")" << std::endl;
+    }
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "[Headless] " << generationsDone << " generations, " << ticks << " ticks in " << seconds << " s\n"
+              << "[Headless] " << (generationsDone / seconds) << " generations/sec, " << (ticks / seconds) << " ticks/sec" << std::endl;
+
+    // Per-role benchmark of the specialised update kernels
+    const char* roleNames[Entity::ROLE_COUNT] = {"Melee", "Ranged", "Healer"};
+    for (int r = 0; r < Entity::ROLE_COUNT; ++r) {
+        double usPerUpdate = roleUpdates[r] > 0 ? 1000.0 * roleMs[r] / (double)roleUpdates[r] : 0.0;
+        std::cout << "[Headless] " << roleNames[r] << " kernel: " << roleMs[r] << " ms for " << roleUpdates[r]
+                  << " entity updates (" << usPerUpdate << " us each)" << std::endl;
+    }
+
+    // Generation rollovers (parallel reproduction)
+    std::cout << "[Headless] Reproduction: " << reproductionMs << " ms for " << generationsDone << " rollovers ("
+              << (generationsDone > 0 ? reproductionMs / generationsDone : 0.0) << " ms each)" << std::endl;
+
+    long long rebuilds = simulation.getNeighborListRebuilds();
+    std::cout << "[Headless] Neighbor lists rebuilt on " << rebuilds << " ticks ("
+              << (100.0 * rebuilds / std::max(1LL, ticks)) << "% of ticks)" << std::endl;
+
+    for (size_t w = 0; w < workerTotals.size(); ++w) {
+        std::cout << "[Headless] Worker " << w << ": busy " << workerTotals[w].busyMs << " ms, idle "
+                  << workerTotals[w].idleMs << " ms, stolen chunks " << workerTotals[w].chunksStolen << std::endl;
+    }
+    return 0;
+}
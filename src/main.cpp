@@ -2,24 +2,23 @@
 #include "constants.h"
 #include "Menu.h"
 #include "Entity/Entity.h"
-#include "Entity/Projectile.h"
 #include "core/Simulation.h"
+#include "SimulationView.h"
 #include <iostream>
 #include <vector>
 #include <map>
 #include <cmath>
 #include <algorithm>
 #include <SDL2/SDL.h>
-#include <ctime>
 #include <memory>
 #include <SDL2/SDL2_gfxPrimitives.h>
 #include <string>
+#include <sstream>
+#include <iomanip>
 
-// Window and world dimensions
+// Window dimensions (the world dimensions live in the simulation core)
 int WINDOW_WIDTH = 1280;
 int WINDOW_HEIGHT = 720;
-int WORLD_WIDTH = 5000;
-int WORLD_HEIGHT = 5000;
 
 // Game states
 enum GameState {
@@ -63,12 +62,10 @@ namespace {
     ControlButton manualRestartButton;
     ControlButton menuButton;
 
-    void drawControlPanel(SDL_Renderer *renderer, int panelX, int currentGen);
+    void drawControlPanel(SDL_Renderer *renderer, int panelX, int currentGen,
+                          const std::vector<ThreadPool::WorkerStats> &workerStats, double neighborRebuildPct);
 }
 
-// Initialize simulation entities
-std::vector<Entity> initializeSimulation(int maxEntities);
-
 int main() {
     Graphics graphics;
     if (graphics.getRenderer()) {
@@ -86,6 +83,7 @@ int main() {
     camera.zoom = 1.0f;
 
     std::unique_ptr<Simulation> simulation = nullptr;
+    SimulationView simulationView;
 
     int maxEntities = 100;
     const int MIN_CELLS = 20;
@@ -148,6 +146,7 @@ int main() {
                     if (action == Menu::START_SIMULATION) {
                         graphics.stopMusic();
                         simulation = std::make_unique<Simulation>(maxEntities);
+                        simulationView.reset();
                         isPaused = false;
                         simulationSpeed = 1;
                         showDebug = false;
@@ -221,6 +220,7 @@ int main() {
                                 clickHandled = true;
                             } else if (SDL_PointInRect(&mousePoint, &restartButton.rect)) {
                                 simulation = std::make_unique<Simulation>(maxEntities);
+                                simulationView.reset();
                                 isPaused = false;
                                 simulationSpeed = 1;
                                 showDebug = false;
@@ -249,7 +249,7 @@ int main() {
                     }
 
                     if (!clickHandled) {
-                        simulation->handleEvent(event, camera);
+                        simulationView.handleEvent(event, camera, *simulation);
                     }
                 }
             }
@@ -261,7 +261,7 @@ int main() {
         } else if (currentState == SIMULATION) {
             if (!isPaused && currentSimRunState == RUNNING) {
                 for (int i = 0; i < simulationSpeed; ++i) {
-                    Simulation::SimUpdateStatus status = simulation->update(simulationSpeed, autoRestart);
+                    Simulation::SimUpdateStatus status = simulation->update(autoRestart);
 
                     if (status == Simulation::SimUpdateStatus::FINISHED) {
                         currentSimRunState = POST_COMBAT;
@@ -274,11 +274,15 @@ int main() {
             SDL_RenderClear(graphics.getRenderer());
             graphics.drawBackground(camera);
 
-            simulation->render(graphics.getRenderer(), showDebug, camera);
+            simulationView.update(*simulation);
+            simulationView.render(graphics.getRenderer(), *simulation, showDebug, camera);
             int genNum = simulation ? simulation->getCurrentGeneration() : 0;
 
             if (controlPanelCurrentX > (float) -CONTROL_PANEL_WIDTH) {
-                drawControlPanel(graphics.getRenderer(), (int) controlPanelCurrentX, genNum);
+                double rebuildPct = 100.0 * (double) simulation->getNeighborListRebuilds() /
+                                    (double) std::max<SimTick>(1, simulation->getCurrentTick());
+                drawControlPanel(graphics.getRenderer(), (int) controlPanelCurrentX, genNum,
+                                 simulation->getWorkerStats(), rebuildPct);
             }
 
             if (settingsIconTexture) {
@@ -297,73 +301,9 @@ int main() {
     return 0;
 }
 
-std::vector<Entity> initializeSimulation(int maxEntities) {
-    std::vector<Entity> newEntities;
-    std::srand(std::time(0));
-
-    const int RANGED_COUNT = maxEntities / 3;
-    const float FRAGILITY_MAX = 0.3f;
-    const float EFFICIENCY_MAX = 0.5f;
-    const float REGEN_MAX = 0.2f;
-    const float MYOPIA_MAX = 0.5f;
-    const float AIM_MAX = 15.0f;
-    const int FERTILITY_MAX = 2;
-    const float AGING_MAX = 0.01f;
-    const float NEUTRAL_FLOAT = 0.0f;
-    const int NEUTRAL_INT = 0;
-
-    for (int i = 0; i < maxEntities; ++i) {
-        int randomRad = 10 + (std::rand() % 31);
-        int randomX = randomRad + (std::rand() % (WORLD_WIDTH - 2 * randomRad));
-        int randomY = randomRad + (std::rand() % (WORLD_HEIGHT - 2 * randomRad));
-
-        std::string name = "E" + std::to_string(i + 1);
-        SDL_Color color = Entity::generateRandomColor();
-
-        float df = NEUTRAL_FLOAT;
-        float se = NEUTRAL_FLOAT;
-        float bhr = NEUTRAL_FLOAT;
-        float mf = NEUTRAL_FLOAT;
-        float ap = NEUTRAL_FLOAT;
-        int ff = NEUTRAL_INT;
-        float ar = NEUTRAL_FLOAT;
-
-        if (std::rand() % 2 != 0) {
-            int geneIndex = std::rand() % 7;
-            switch (geneIndex) {
-                case 0:
-                    df = (float) (std::rand() % 101) / 100.0f * FRAGILITY_MAX;
-                    break;
-                case 1:
-                    se = (float) (std::rand() % 101) / 100.0f * EFFICIENCY_MAX;
-                    break;
-                case 2:
-                    bhr = (float) (std::rand() % 101) / 100.0f * REGEN_MAX;
-                    break;
-                case 3:
-                    mf = (float) (std::rand() % 101) / 100.0f * MYOPIA_MAX;
-                    break;
-                case 4:
-                    ap = (float) (std::rand() % 101) / 100.0f * AIM_MAX;
-                    break;
-                case 5:
-                    ff = (std::rand() % (FERTILITY_MAX + 1));
-                    break;
-                case 6:
-                    ar = (float) (std::rand() % 101) / 100.0f * AGING_MAX;
-                    break;
-            }
-        }
-        float newGeneticCode[12];
-        newEntities.emplace_back(
-                name, randomX, randomY, color, newGeneticCode, 0, "NONE", "NONE"
-        );
-    }
-    return newEntities;
-}
-
 namespace {
-    void drawControlPanel(SDL_Renderer *renderer, int panelX, int currentGen) {
+    void drawControlPanel(SDL_Renderer *renderer, int panelX, int currentGen,
+                          const std::vector<ThreadPool::WorkerStats> &workerStats, double neighborRebuildPct) {
         SDL_Rect panelRect = {panelX, 0, CONTROL_PANEL_WIDTH, WINDOW_HEIGHT};
         SDL_SetRenderDrawColor(renderer, 30, 30, 30, 220);
         SDL_RenderFillRect(renderer, &panelRect);
@@ -434,6 +374,23 @@ namespace {
 
         drawButton(menuButton, "Return to Menu");
 
+        // Per-worker load balance of the last tick
+        if (showDebug) {
+            stringRGBA(renderer, x, y, "--- Workers (last tick) ---", titleColor.r, titleColor.g, titleColor.b, 255);
+            y += 20;
+            for (size_t w = 0; w < workerStats.size(); ++w) {
+                std::ostringstream line;
+                line << "W" << w << " busy " << std::fixed << std::setprecision(2) << workerStats[w].busyMs
+                     << " idle " << workerStats[w].idleMs << " ms";
+                stringRGBA(renderer, x, y, line.str().c_str(), textColor.r, textColor.g, textColor.b, 255);
+                y += 15;
+            }
+            std::ostringstream rebuildLine;
+            rebuildLine << "Neighbor rebuilds: " << std::fixed << std::setprecision(1) << neighborRebuildPct << "% of ticks";
+            stringRGBA(renderer, x, y, rebuildLine.str().c_str(), textColor.r, textColor.g, textColor.b, 255);
+            y += 15;
+        }
+
         speedDropdownRects.clear();
         if (isSpeedDropdownOpen) {
             int ddX = speedButton.rect.x;